@@ -0,0 +1,102 @@
+#define _POSIX_C_SOURCE 199309L
+#include "collex_bitset.h"
+#include "collex_vector.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_BITS 1000000000UL
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_byte_vector(size_t n_bits) {
+    collex_vector_t *a = collex_vector_init(1, NULL);
+    collex_vector_t *b = collex_vector_init(1, NULL);
+
+    double start = now();
+    for (size_t i = 0; i < n_bits; i++) {
+        unsigned char x = i % 3 == 0, y = i % 5 == 0;
+        collex_vector_push(a, &x);
+        collex_vector_push(b, &y);
+    }
+    double built = now();
+
+    size_t count = 0;
+    const unsigned char *flags = a->buffer;
+    for (size_t i = 0; i < n_bits; i++) {
+        count += flags[i];
+    }
+    double counted = now();
+
+    unsigned char *dest = a->buffer;
+    const unsigned char *src = b->buffer;
+    for (size_t i = 0; i < n_bits; i++) {
+        dest[i] &= src[i];
+    }
+    double anded = now();
+
+    size_t found = 0;
+    for (size_t i = 0; i < n_bits; i++) {
+        found += dest[i] != 0;
+    }
+    double scanned = now();
+
+    printf("byte vector (%zu MiB): build %.3fs, popcount %.3fs, and %.3fs, scan %.3fs (%zu, %zu)\n",
+           2 * n_bits >> 20, built - start, counted - built, anded - counted, scanned - anded, count, found);
+    collex_vector_free(a);
+    collex_vector_free(b);
+}
+
+static void bench_bitset(size_t n_bits) {
+    collex_bitset_t *a = collex_bitset_init(n_bits);
+    collex_bitset_t *b = collex_bitset_init(n_bits);
+
+    double start = now();
+    for (size_t i = 0; i < n_bits; i++) {
+        if (i % 3 == 0) {
+            collex_bitset_set(a, i);
+        }
+        if (i % 5 == 0) {
+            collex_bitset_set(b, i);
+        }
+    }
+    double built = now();
+
+    size_t count = collex_bitset_popcount(a);
+    double counted = now();
+
+    collex_bitset_and(a, b);
+    double anded = now();
+
+    size_t found = 0, index = 0;
+    while (collex_bitset_find_next(a, index, &index) == 0) {
+        found++;
+        index++;
+    }
+    double scanned = now();
+
+    printf("collex_bitset_t (%zu MiB): build %.3fs, popcount %.3fs, and %.3fs, scan %.3fs (%zu, %zu)\n",
+           2 * a->n_words * 8 >> 20, built - start, counted - built, anded - counted, scanned - anded, count, found);
+
+    double rank_start = now();
+    size_t rank_sum = 0;
+    for (size_t i = 0; i < 100; i++) {
+        rank_sum += collex_bitset_rank(a, n_bits / 100 * i);
+    }
+    double rank_end = now();
+    printf("collex_bitset_t: 100 rank queries %.3fs (%zu)\n", rank_end - rank_start, rank_sum);
+
+    collex_bitset_free(a);
+    collex_bitset_free(b);
+}
+
+int main(int argc, char **argv) {
+    size_t n_bits = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_BITS;
+    bench_byte_vector(n_bits);
+    bench_bitset(n_bits);
+    return 0;
+}
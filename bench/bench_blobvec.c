@@ -0,0 +1,75 @@
+#define _POSIX_C_SOURCE 199309L
+#include "collex_blobvec.h"
+#include "collex_vector.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define N_STRINGS 10000000
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int make_key(char *buf, size_t i) { return sprintf(buf, "key-%zu", i * 2654435761u % 100000000u); }
+
+static void bench_pointer_vector(void) {
+    char buf[32];
+    collex_vector_t *vec = collex_vector_init(sizeof(char *), NULL);
+
+    double start = now();
+    for (size_t i = 0; i < N_STRINGS; i++) {
+        int n = make_key(buf, i);
+        char *str = malloc(n + 1);
+        memcpy(str, buf, n + 1);
+        collex_vector_push(vec, &str);
+    }
+    double built = now();
+
+    size_t checksum = 0;
+    for (size_t i = 0; i < vec->len; i++) {
+        const char *str = *(char *const *)collex_vector_get(vec, i);
+        size_t len = strlen(str);
+        checksum += len + (unsigned char)str[len - 1];
+    }
+    double scanned = now();
+
+    printf("pointer-per-string: build %.3fs, scan %.3fs (checksum %zu)\n", built - start, scanned - built, checksum);
+
+    for (size_t i = 0; i < vec->len; i++) {
+        free(*(char **)collex_vector_get(vec, i));
+    }
+    collex_vector_free(vec);
+}
+
+static void bench_blobvec(void) {
+    char buf[32];
+    collex_blobvec_t *blobvec = collex_blobvec_init();
+
+    double start = now();
+    for (size_t i = 0; i < N_STRINGS; i++) {
+        int n = make_key(buf, i);
+        collex_blobvec_push(blobvec, buf, n);
+    }
+    double built = now();
+
+    size_t checksum = 0;
+    for (size_t i = 0; i < blobvec->len; i++) {
+        size_t len;
+        const unsigned char *str = collex_blobvec_get(blobvec, i, &len);
+        checksum += len + str[len - 1];
+    }
+    double scanned = now();
+
+    printf("collex_blobvec_t:   build %.3fs, scan %.3fs (checksum %zu)\n", built - start, scanned - built, checksum);
+    collex_blobvec_free(blobvec);
+}
+
+int main() {
+    bench_pointer_vector();
+    bench_blobvec();
+    return 0;
+}
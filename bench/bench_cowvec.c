@@ -0,0 +1,167 @@
+#define _POSIX_C_SOURCE 200112L
+#include "collex_cowvec.h"
+#include "collex_vector.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define N_ELEMS 1000000
+#define RUN_SECONDS 1.0
+#define DEFAULT_MAX_READERS 8
+#define MAX_READERS 64
+
+typedef struct {
+    collex_cowvec_t *cowvec;
+    collex_vector_t *vector;
+    pthread_rwlock_t *lock;
+    size_t reader;
+    size_t reads;
+    uint64_t checksum;
+} reader_arg_t;
+
+static atomic_int running;
+static atomic_size_t writes;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t next_rand(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void *cowvec_reader(void *arg) {
+    reader_arg_t *r = arg;
+    uint64_t state = 0x9e3779b97f4a7c15ULL + r->reader;
+    size_t reads = 0;
+    uint64_t checksum = 0;
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        const collex_cowvec_snapshot_t *snap = collex_cowvec_read_begin(r->cowvec, r->reader);
+        checksum += *(const uint64_t *)collex_cowvec_snapshot_get(snap, next_rand(&state) % snap->len);
+        collex_cowvec_read_end(r->cowvec, r->reader);
+        reads++;
+    }
+    r->reads = reads;
+    r->checksum = checksum;
+    return NULL;
+}
+
+static void *cowvec_writer(void *arg) {
+    collex_cowvec_t *cowvec = arg;
+    uint64_t state = 42;
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        uint64_t value = next_rand(&state);
+        collex_cowvec_set(cowvec, value % N_ELEMS, &value);
+        atomic_fetch_add_explicit(&writes, 1, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static void *locked_reader(void *arg) {
+    reader_arg_t *r = arg;
+    uint64_t state = 0x9e3779b97f4a7c15ULL + r->reader;
+    size_t reads = 0;
+    uint64_t checksum = 0;
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        pthread_rwlock_rdlock(r->lock);
+        checksum += *(const uint64_t *)collex_vector_get(r->vector, next_rand(&state) % r->vector->len);
+        pthread_rwlock_unlock(r->lock);
+        reads++;
+    }
+    r->reads = reads;
+    r->checksum = checksum;
+    return NULL;
+}
+
+static void *locked_writer(void *arg) {
+    reader_arg_t *w = arg;
+    uint64_t state = 42;
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        uint64_t value = next_rand(&state);
+        pthread_rwlock_wrlock(w->lock);
+        collex_vector_set(w->vector, value % N_ELEMS, &value);
+        pthread_rwlock_unlock(w->lock);
+        atomic_fetch_add_explicit(&writes, 1, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static void run(const char *name, size_t n_readers, void *(*reader)(void *), void *(*writer)(void *),
+                void *writer_arg, reader_arg_t *template) {
+    pthread_t threads[MAX_READERS + 1];
+    reader_arg_t args[MAX_READERS];
+
+    atomic_store(&running, 1);
+    atomic_store(&writes, 0);
+    for (size_t i = 0; i < n_readers; i++) {
+        args[i] = *template;
+        args[i].reader = i;
+        pthread_create(&threads[i], NULL, reader, &args[i]);
+    }
+    pthread_create(&threads[n_readers], NULL, writer, writer_arg);
+
+    double start = now();
+    struct timespec pause = {0, 10000000};
+    while (now() - start < RUN_SECONDS) {
+        nanosleep(&pause, NULL);
+    }
+    atomic_store(&running, 0);
+
+    size_t reads = 0;
+    uint64_t checksum = 0;
+    for (size_t i = 0; i <= n_readers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = now() - start;
+    for (size_t i = 0; i < n_readers; i++) {
+        reads += args[i].reads;
+        checksum ^= args[i].checksum;
+    }
+
+    printf("%-16s %2zu readers: %8.2f Mreads/s, %8.0f writes/s (checksum %llx)\n", name, n_readers,
+           reads / elapsed / 1e6, atomic_load(&writes) / elapsed, (unsigned long long)checksum);
+}
+
+int main(int argc, char **argv) {
+    size_t max_readers = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_MAX_READERS;
+    if (max_readers == 0 || max_readers > MAX_READERS) {
+        max_readers = DEFAULT_MAX_READERS;
+    }
+
+    uint64_t *values = malloc(N_ELEMS * sizeof(uint64_t));
+    for (size_t i = 0; i < N_ELEMS; i++) {
+        values[i] = i;
+    }
+
+    collex_cowvec_t *cowvec = collex_cowvec_init(sizeof(uint64_t), max_readers);
+    collex_cowvec_append(cowvec, values, N_ELEMS);
+
+    collex_vector_t *vector = collex_vector_init(sizeof(uint64_t), NULL);
+    for (size_t i = 0; i < N_ELEMS; i++) {
+        collex_vector_push(vector, &values[i]);
+    }
+    pthread_rwlock_t lock;
+    pthread_rwlock_init(&lock, NULL);
+
+    for (size_t n = 1; n <= max_readers; n *= 2) {
+        reader_arg_t cow_template = {cowvec, NULL, NULL, 0, 0, 0};
+        run("collex_cowvec_t", n, cowvec_reader, cowvec_writer, cowvec, &cow_template);
+
+        reader_arg_t locked_template = {NULL, vector, &lock, 0, 0, 0};
+        run("rwlock + vector", n, locked_reader, locked_writer, &locked_template, &locked_template);
+    }
+
+    pthread_rwlock_destroy(&lock);
+    collex_vector_free(vector);
+    collex_cowvec_free(cowvec);
+    free(values);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#define _POSIX_C_SOURCE 199309L
+#include "collex_list.h"
+#include "collex_lru.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define N_KEYS 1000000
+#define N_OPS 10000000
+#define N_LIST_OPS 200000
+#define ZIPF_S 0.99
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static double next_uniform(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (rng_state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Draws keys from a Zipf distribution by binary search over its CDF; key 0
+ * is the most popular one. */
+static uint64_t *zipf_stream(size_t n_ops) {
+    double *cdf = malloc(N_KEYS * sizeof(double));
+    double sum = 0;
+    for (size_t k = 0; k < N_KEYS; k++) {
+        sum += 1.0 / pow((double)(k + 1), ZIPF_S);
+        cdf[k] = sum;
+    }
+
+    uint64_t *stream = malloc(n_ops * sizeof(uint64_t));
+    for (size_t i = 0; i < n_ops; i++) {
+        double u = next_uniform() * sum;
+        size_t lo = 0, hi = N_KEYS - 1;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (cdf[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        stream[i] = lo;
+    }
+    free(cdf);
+    return stream;
+}
+
+static void bench_lru(const uint64_t *stream, size_t n_ops, size_t cap) {
+    collex_lru_t *lru = collex_lru_init(cap, sizeof(uint64_t), sizeof(uint64_t), NULL, NULL, NULL);
+
+    size_t hits = 0;
+    double start = now();
+    for (size_t i = 0; i < n_ops; i++) {
+        if (collex_lru_get(lru, &stream[i])) {
+            hits++;
+        } else {
+            collex_lru_put(lru, &stream[i], &stream[i]);
+        }
+    }
+    double elapsed = now() - start;
+
+    printf("collex_lru_t  cap %7zu: hit rate %5.2f%%, %6.2f Mops/s\n", cap, 100.0 * hits / n_ops,
+           n_ops / elapsed / 1e6);
+    collex_lru_free(lru);
+}
+
+static void u64_free(void *value) { free(value); }
+
+static int u64_compare(void *x, void *y) {
+    uint64_t a = *(uint64_t *)x;
+    uint64_t b = *(uint64_t *)y;
+    return (a > b) - (a < b);
+}
+
+/* The pattern the cache replaces: scan the list for the key, then move it to
+ * the front with remove/insert by index. */
+static void bench_list(const uint64_t *stream, size_t n_ops, size_t cap) {
+    collex_list_t *list = collex_list_init(sizeof(uint64_t), u64_free, u64_compare);
+
+    size_t hits = 0;
+    double start = now();
+    for (size_t i = 0; i < n_ops; i++) {
+        uint64_t key = stream[i];
+        size_t pos = 0;
+        collex_list_node_t *node = list->sentinel;
+        while (node && list->compare(node->value, &key) != 0) {
+            node = node->next;
+            pos++;
+        }
+
+        if (node) {
+            hits++;
+            collex_list_remove(list, pos);
+        } else if (list->len == cap) {
+            collex_list_remove(list, list->len - 1);
+        }
+        collex_list_insert(list, 0, &key);
+    }
+    double elapsed = now() - start;
+
+    printf("collex_list_t cap %7zu: hit rate %5.2f%%, %6.2f Mops/s\n", cap, 100.0 * hits / n_ops,
+           n_ops / elapsed / 1e6);
+    collex_list_free(list);
+}
+
+int main() {
+    uint64_t *stream = zipf_stream(N_OPS);
+    size_t caps[] = {1000, 10000, 100000};
+
+    for (size_t i = 0; i < sizeof(caps) / sizeof(caps[0]); i++) {
+        bench_lru(stream, N_OPS, caps[i]);
+    }
+    bench_list(stream, N_LIST_OPS, caps[0]);
+
+    free(stream);
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ *  @file collex_bitset.h
+ *  @brief A dynamic bitset packed into 64-bit words with utility functions.
+ *
+ *  Copyright 2025, Sang H. Cao, All Rights Reserved
+ *
+ *  @author Sang H. Cao
+ */
+#ifndef __COLLEX_BITSET_
+#define __COLLEX_BITSET_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Implementations of the bulk bitset kernels.
+ */
+typedef enum {
+    COLLEX_BITSET_KERNEL_SCALAR,
+    COLLEX_BITSET_KERNEL_POPCNT,
+    COLLEX_BITSET_KERNEL_AVX2,
+} collex_bitset_kernel_t;
+
+/**
+ * @brief A dynamic array of bits.
+ *
+ * Bits are packed 64 to a word, least significant bit first. Bits past len in
+ * the last word are always kept clear. Bulk operations (boolean ops, popcount,
+ * rank and select) run over the word array using kernels picked at load time
+ * for the instruction sets the CPU supports.
+ */
+typedef struct {
+    uint64_t *words;
+    size_t len;
+    size_t n_words;
+} collex_bitset_t;
+
+/**
+ *  @brief Initializes a new bitset with all bits clear.
+ *  @param len Number of bits.
+ *  @return Pointer to a newly allocated bitset instance or NULL on failure.
+ */
+collex_bitset_t *collex_bitset_init(size_t len);
+
+/**
+ *  @brief Frees all resources associated with the bitset.
+ *  @param bitset Pointer to the bitset instance.
+ */
+void collex_bitset_free(collex_bitset_t *bitset);
+
+/**
+ *  @brief Changes the number of bits in the bitset. New bits are clear.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param len New number of bits.
+ *  @return 0 on success or -1 if memory allocation fails.
+ */
+int collex_bitset_resize(collex_bitset_t *bitset, size_t len);
+
+/**
+ *  @brief Sets the bit at the specified index.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param index Index of the bit (0-based).
+ *  @return 0 on success or -1 if the index is out of range.
+ */
+int collex_bitset_set(collex_bitset_t *bitset, size_t index);
+
+/**
+ *  @brief Clears the bit at the specified index.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param index Index of the bit (0-based).
+ *  @return 0 on success or -1 if the index is out of range.
+ */
+int collex_bitset_clear(collex_bitset_t *bitset, size_t index);
+
+/**
+ *  @brief Tests the bit at the specified index.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param index Index of the bit (0-based).
+ *  @return 1 if the bit is set, 0 if it is clear or -1 if the index is out of range.
+ */
+int collex_bitset_test(collex_bitset_t *bitset, size_t index);
+
+/**
+ *  @brief Computes dest &= src.
+ *  @param dest Pointer to the bitset receiving the result.
+ *  @param src Pointer to the other operand.
+ *  @return 0 on success or -1 if the bitsets differ in length.
+ */
+int collex_bitset_and(collex_bitset_t *dest, const collex_bitset_t *src);
+
+/**
+ *  @brief Computes dest |= src.
+ *  @param dest Pointer to the bitset receiving the result.
+ *  @param src Pointer to the other operand.
+ *  @return 0 on success or -1 if the bitsets differ in length.
+ */
+int collex_bitset_or(collex_bitset_t *dest, const collex_bitset_t *src);
+
+/**
+ *  @brief Computes dest ^= src.
+ *  @param dest Pointer to the bitset receiving the result.
+ *  @param src Pointer to the other operand.
+ *  @return 0 on success or -1 if the bitsets differ in length.
+ */
+int collex_bitset_xor(collex_bitset_t *dest, const collex_bitset_t *src);
+
+/**
+ *  @brief Computes dest &= ~src.
+ *  @param dest Pointer to the bitset receiving the result.
+ *  @param src Pointer to the other operand.
+ *  @return 0 on success or -1 if the bitsets differ in length.
+ */
+int collex_bitset_andnot(collex_bitset_t *dest, const collex_bitset_t *src);
+
+/**
+ *  @brief Counts the set bits in the bitset.
+ *  @param bitset Pointer to the bitset instance.
+ *  @return Number of set bits.
+ */
+size_t collex_bitset_popcount(collex_bitset_t *bitset);
+
+/**
+ *  @brief Finds the first set bit.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param index Pointer where the index of the bit will be stored.
+ *  @return 0 on success or -1 if no bit is set.
+ */
+int collex_bitset_find_first(collex_bitset_t *bitset, size_t *index);
+
+/**
+ *  @brief Finds the first set bit at or after a position.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param from Position to start searching from (0-based).
+ *  @param index Pointer where the index of the bit will be stored.
+ *  @return 0 on success or -1 if no bit at or after from is set.
+ */
+int collex_bitset_find_next(collex_bitset_t *bitset, size_t from, size_t *index);
+
+/**
+ *  @brief Counts the set bits strictly before a position.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param index Position to count up to (0-based). Values past len count the whole bitset.
+ *  @return Number of set bits in [0, index).
+ */
+size_t collex_bitset_rank(collex_bitset_t *bitset, size_t index);
+
+/**
+ *  @brief Finds the position of the k-th set bit.
+ *  @param bitset Pointer to the bitset instance.
+ *  @param k Rank of the bit to find (0-based).
+ *  @param index Pointer where the index of the bit will be stored.
+ *  @return 0 on success or -1 if fewer than k + 1 bits are set.
+ */
+int collex_bitset_select(collex_bitset_t *bitset, size_t k, size_t *index);
+
+/**
+ *  @brief Overrides the kernels picked at load time, e.g. to test or benchmark
+ *  each implementation. Must not be called while another thread uses any bitset.
+ *  @param kernel Kernel implementation to use.
+ *  @return 0 on success or -1 if the CPU does not support the kernel.
+ */
+int collex_bitset_use_kernel(collex_bitset_kernel_t kernel);
+
+#endif
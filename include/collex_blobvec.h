@@ -0,0 +1,109 @@
+/**
+ *  @file collex_blobvec.h
+ *  @brief A variable-length blob vector backed by a contiguous byte arena.
+ *
+ *  Copyright 2025, Sang H. Cao, All Rights Reserved
+ *
+ *  @author Sang H. Cao
+ */
+#ifndef __COLLEX_BLOBVEC_
+#define __COLLEX_BLOBVEC_
+#define __COLLEX_BLOBVEC_INIT_CAP_ 4
+#define __COLLEX_BLOBVEC_INIT_DATA_CAP_ 64
+
+#include <stddef.h>
+
+/**
+ * @brief Location of a single blob inside the byte arena.
+ */
+typedef struct {
+    size_t offset;
+    size_t len;
+} collex_blobvec_span_t;
+
+/**
+ * @brief A dynamic array of variable-length byte strings.
+ *
+ * All payloads are stored back to back in one growable byte buffer, while
+ * a separate span array records where each element starts and how long it
+ * is. Removing an element only drops its span; the bytes it occupied are
+ * reclaimed by compaction, which runs once enough of the arena is unused.
+ */
+typedef struct {
+    char *data;
+    size_t data_len;
+    size_t data_cap;
+    size_t live;
+
+    collex_blobvec_span_t *spans;
+    size_t len;
+    size_t cap;
+} collex_blobvec_t;
+
+/**
+ *  @brief Initializes a new blob vector.
+ *  @return Pointer to a newly allocated blob vector instance or NULL on failure.
+ */
+collex_blobvec_t *collex_blobvec_init(void);
+
+/**
+ *  @brief Frees all resources associated with the blob vector.
+ *  @param blobvec Pointer to the blob vector instance.
+ */
+void collex_blobvec_free(collex_blobvec_t *blobvec);
+
+/**
+ *  @brief Appends a copy of a byte string to the blob vector.
+ *  @param blobvec Pointer to the blob vector instance.
+ *  @param value Pointer to the bytes to be added. May be NULL if len is 0, and may
+ *  point into the blob vector itself (e.g. a pointer from collex_blobvec_get).
+ *  @param len Number of bytes to copy.
+ *  @return 0 on success or -1 if memory allocation fails.
+ */
+int collex_blobvec_push(collex_blobvec_t *blobvec, const void *value, size_t len);
+
+/**
+ *  @brief Appends several byte strings stored back to back in one buffer.
+ *  Either all elements are appended or, on failure, none are.
+ *  @param blobvec Pointer to the blob vector instance.
+ *  @param values Pointer to the concatenated payloads. May point into the blob vector itself.
+ *  @param lens Array holding the length of each payload.
+ *  @param count Number of payloads described by lens.
+ *  @return 0 on success or -1 if memory allocation fails.
+ */
+int collex_blobvec_append(collex_blobvec_t *blobvec, const void *values, const size_t *lens, size_t count);
+
+/**
+ *  @brief Retrieves the element at a specific index in the blob vector.
+ *  The returned pointer is invalidated by any call that modifies the blob vector.
+ *  @param blobvec Pointer to the blob vector instance.
+ *  @param index Index of the element (0-based).
+ *  @param len Pointer where the element length will be stored. May be NULL.
+ *  @return Pointer to the element bytes or NULL if the index is out of range.
+ */
+const void *collex_blobvec_get(collex_blobvec_t *blobvec, size_t index, size_t *len);
+
+/**
+ *  @brief Removes the element at the specified index from the blob vector.
+ *  @param blobvec Pointer to the blob vector instance.
+ *  @param index Position where the element will be removed (0-based).
+ *  @return 0 on success or -1 if the index is out of range.
+ */
+int collex_blobvec_remove(collex_blobvec_t *blobvec, size_t index);
+
+/**
+ *  @brief Shrinks the blob vector to the first len elements.
+ *  @param blobvec Pointer to the blob vector instance.
+ *  @param len New number of elements.
+ *  @return 0 on success or -1 if len is greater than the current length.
+ */
+int collex_blobvec_truncate(collex_blobvec_t *blobvec, size_t len);
+
+/**
+ *  @brief Moves all elements to the front of the arena, discarding bytes left
+ *  behind by removed elements.
+ *  @param blobvec Pointer to the blob vector instance.
+ */
+void collex_blobvec_compact(collex_blobvec_t *blobvec);
+
+#endif
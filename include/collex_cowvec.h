@@ -0,0 +1,158 @@
+/**
+ *  @file collex_cowvec.h
+ *  @brief A copy-on-write vector with lock-free snapshots for concurrent readers.
+ *
+ *  Copyright 2025, Sang H. Cao, All Rights Reserved
+ *
+ *  @author Sang H. Cao
+ */
+#ifndef __COLLEX_COWVEC_
+#define __COLLEX_COWVEC_
+#define __COLLEX_COWVEC_CHUNK_LEN_ 512
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief A fixed-size block of elements, shared by every version that has not
+ * modified it. Slots at or past filled have never been written, so no version
+ * can see them and the writer may append into them in place.
+ */
+typedef struct {
+    size_t refs;
+    size_t filled;
+    char data[];
+} collex_cowvec_chunk_t;
+
+/**
+ * @brief An immutable version of the vector.
+ *
+ * Elements are split into chunks of __COLLEX_COWVEC_CHUNK_LEN_ elements. A
+ * write copies only the chunk it touches and the chunk table, so unchanged
+ * chunks are shared with older versions.
+ */
+typedef struct collex_cowvec_snapshot {
+    size_t len;
+    size_t elem_size;
+    size_t n_chunks;
+    collex_cowvec_chunk_t **chunks;
+
+    uint64_t retired_at;
+    struct collex_cowvec_snapshot *next_retired;
+} collex_cowvec_snapshot_t;
+
+/**
+ * @brief Epoch announced by one reader, padded to its own cache line.
+ */
+typedef struct {
+    _Atomic uint64_t epoch;
+    char pad[64 - sizeof(uint64_t)];
+} collex_cowvec_reader_t;
+
+/**
+ * @brief A vector read by many threads and written by one.
+ *
+ * Readers take a snapshot without locking: they announce the current epoch in
+ * their own slot and load the published version. The writer publishes each
+ * change as a new version with a single atomic exchange and frees retired
+ * versions once no reader slot holds an epoch old enough to see them.
+ *
+ * All write functions must be called from one thread at a time. Each reader
+ * thread must use its own reader slot.
+ */
+typedef struct {
+    size_t elem_size;
+    _Atomic(collex_cowvec_snapshot_t *) current;
+    _Atomic uint64_t epoch;
+
+    collex_cowvec_reader_t *readers;
+    size_t n_readers;
+
+    collex_cowvec_snapshot_t *retired;
+} collex_cowvec_t;
+
+/**
+ *  @brief Initializes a new empty copy-on-write vector.
+ *  @param elem_size Size of element. Must not be 0.
+ *  @param n_readers Number of reader slots. Must not be 0.
+ *  @return Pointer to a newly allocated vector instance or NULL on failure.
+ */
+collex_cowvec_t *collex_cowvec_init(size_t elem_size, size_t n_readers);
+
+/**
+ *  @brief Frees all resources associated with the vector.
+ *  No reader may hold a snapshot while the vector is freed.
+ *  @param vector Pointer to the vector instance.
+ */
+void collex_cowvec_free(collex_cowvec_t *vector);
+
+/**
+ *  @brief Takes a snapshot of the current version.
+ *  The snapshot stays valid until collex_cowvec_read_end is called with the
+ *  same reader slot. Snapshots may not be nested on one slot.
+ *  @param vector Pointer to the vector instance.
+ *  @param reader Index of the calling thread's reader slot.
+ *  @return Pointer to the snapshot or NULL if the reader slot is out of range.
+ */
+const collex_cowvec_snapshot_t *collex_cowvec_read_begin(collex_cowvec_t *vector, size_t reader);
+
+/**
+ *  @brief Releases the snapshot held by a reader slot.
+ *  @param vector Pointer to the vector instance.
+ *  @param reader Index of the calling thread's reader slot.
+ */
+void collex_cowvec_read_end(collex_cowvec_t *vector, size_t reader);
+
+/**
+ *  @brief Retrieves the pointer to element at a specific index in a snapshot.
+ *  @param snapshot Pointer to the snapshot.
+ *  @param index Index of the element (0-based).
+ *  @return Pointer to the element or NULL if the index is out of range.
+ */
+const void *collex_cowvec_snapshot_get(const collex_cowvec_snapshot_t *snapshot, size_t index);
+
+/**
+ *  @brief Replaces the element at the specified index and publishes the result.
+ *  Only the chunk holding the element is copied.
+ *  @param vector Pointer to the vector instance.
+ *  @param index Position where the new element will be set (0-based).
+ *  @param value Pointer to the element to be set.
+ *  @return 0 on success or -1 if the index is out of range or memory allocation fails.
+ */
+int collex_cowvec_set(collex_cowvec_t *vector, size_t index, const void *value);
+
+/**
+ *  @brief Pushes a new element and publishes the result.
+ *  @param vector Pointer to the vector instance.
+ *  @param value Pointer to the element to be added.
+ *  @return 0 on success or -1 if memory allocation fails.
+ */
+int collex_cowvec_push(collex_cowvec_t *vector, const void *value);
+
+/**
+ *  @brief Pushes several elements and publishes the result once.
+ *  @param vector Pointer to the vector instance.
+ *  @param values Pointer to count contiguous elements.
+ *  @param count Number of elements to add.
+ *  @return 0 on success or -1 if memory allocation fails.
+ */
+int collex_cowvec_append(collex_cowvec_t *vector, const void *values, size_t count);
+
+/**
+ *  @brief Pops the last element and publishes the result.
+ *  @param vector Pointer to the vector instance.
+ *  @param buffer Pointer to the memory where the popped element will be stored. May be NULL.
+ *  @return 0 on success or -1 if the vector is empty or memory allocation fails.
+ */
+int collex_cowvec_pop(collex_cowvec_t *vector, void *buffer);
+
+/**
+ *  @brief Frees retired versions that no reader can still see.
+ *  Writes call this automatically; it only needs to be called directly to
+ *  release memory after readers finish while no writes happen.
+ *  @param vector Pointer to the vector instance.
+ */
+void collex_cowvec_reclaim(collex_cowvec_t *vector);
+
+#endif
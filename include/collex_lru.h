@@ -0,0 +1,136 @@
+/**
+ *  @file collex_lru.h
+ *  @brief A fixed-capacity LRU cache struct with utility functions.
+ *
+ *  Copyright 2025, Sang H. Cao, All Rights Reserved
+ *
+ *  @author Sang H. Cao
+ */
+#ifndef __COLLEX_LRU_
+#define __COLLEX_LRU_
+
+#include <stddef.h>
+
+/**
+ * @brief An entry in the cache.
+ *
+ * Nodes are allocated once, up front, and linked into a doubly linked list
+ * ordered from most to least recently used. Unused nodes are chained through
+ * next. Key and value point into storage owned by the cache.
+ */
+typedef struct collex_lru_node {
+    void *key;
+    void *value;
+    size_t hash;
+    struct collex_lru_node *prev, *next;
+} collex_lru_node_t;
+
+/**
+ * @brief A generic least-recently-used cache with a fixed capacity.
+ *
+ * Lookups go through an open-addressing hash index (linear probing) that
+ * points at list nodes, so get, put and evict all run in O(1). When the cache
+ * is full, inserting a new key evicts the least recently used entry.
+ */
+typedef struct {
+    size_t len;
+    size_t cap;
+    size_t key_size;
+    size_t value_size;
+
+    collex_lru_node_t *nodes;
+    collex_lru_node_t *head, *tail, *unused;
+    char *keys;
+    char *values;
+
+    collex_lru_node_t **index;
+    size_t index_mask;
+
+    /**
+     * @brief Hash function for keys.
+     * @param key Pointer to the key.
+     * @return Hash of the key.
+     */
+    size_t (*hash)(const void *key);
+
+    /**
+     *  @brief Comparison function for keys.
+     *  @param x Pointer to the first key.
+     *  @param y Pointer to the second key.
+     *  @return 0 if *x == *y, non-zero otherwise.
+     */
+    int (*compare)(void *x, void *y);
+
+    /**
+     * @brief A function pointer called on a value when it leaves the cache.
+     * Values are stored inline in memory owned by the cache, so unlike the
+     * free callback of collex_list_t this must only release resources the
+     * value refers to and never the value pointer itself.
+     * @param value Pointer to the value being dropped.
+     */
+    void (*release)(void *value);
+} collex_lru_t;
+
+/**
+ * @brief Initializes a new empty LRU cache.
+ * @param cap Maximum number of entries. Must not be 0.
+ * @param key_size Size of a key. Must not be 0.
+ * @param value_size Size of a value.
+ * @param hash Hash function for keys, or NULL to hash the raw key bytes.
+ * @param compare Comparison function for keys, or NULL to compare the raw key bytes.
+ * @param release Function called on values that leave the cache, or NULL.
+ * @return Pointer to a new cache instance, or NULL on allocation failure.
+ */
+collex_lru_t *collex_lru_init(size_t cap, size_t key_size, size_t value_size, size_t (*hash)(const void *key),
+                              int (*compare)(void *x, void *y), void (*release)(void *value));
+
+/**
+ * @brief Frees all memory used by the cache, calling release on every value.
+ * @param lru Pointer to the cache to be freed.
+ */
+void collex_lru_free(collex_lru_t *lru);
+
+/**
+ * @brief Looks up a key and marks it as most recently used.
+ * The returned pointer stays valid until the entry leaves the cache.
+ * @param lru Pointer to the cache.
+ * @param key Pointer to the key.
+ * @return Pointer to the cached value, or NULL if the key is not cached.
+ */
+void *collex_lru_get(collex_lru_t *lru, const void *key);
+
+/**
+ * @brief Looks up a key without changing its recency.
+ * @param lru Pointer to the cache.
+ * @param key Pointer to the key.
+ * @return Pointer to the cached value, or NULL if the key is not cached.
+ */
+void *collex_lru_peek(collex_lru_t *lru, const void *key);
+
+/**
+ * @brief Inserts or replaces a value and marks it as most recently used.
+ * A replaced value is passed to release. If the cache is full, the least
+ * recently used entry is evicted first.
+ * @param lru Pointer to the cache.
+ * @param key Pointer to the key.
+ * @param value Pointer to the value to copy into the cache.
+ * @return 0 on success, -1 on invalid input.
+ */
+int collex_lru_put(collex_lru_t *lru, const void *key, const void *value);
+
+/**
+ * @brief Removes the entry for a key, calling release on its value.
+ * @param lru Pointer to the cache.
+ * @param key Pointer to the key.
+ * @return 0 on success, -1 if the key is not cached.
+ */
+int collex_lru_remove(collex_lru_t *lru, const void *key);
+
+/**
+ * @brief Evicts the least recently used entry, calling release on its value.
+ * @param lru Pointer to the cache.
+ * @return 0 on success, -1 if the cache is empty.
+ */
+int collex_lru_evict(collex_lru_t *lru);
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ *  @file collex_soa.h
+ *  @brief A generic struct-of-arrays container with utility functions.
+ *
+ *  Copyright 2025, Sang H. Cao, All Rights Reserved
+ *
+ *  @author Sang H. Cao
+ */
+#ifndef __COLLEX_SOA_
+#define __COLLEX_SOA_
+#define __COLLEX_SOA_INIT_CAP_ 4
+
+#include <stddef.h>
+
+/**
+ * @brief A generic struct-of-arrays (columnar) structure.
+ *
+ * Each record is made of a fixed list of fields. Instead of storing records
+ * one after another, every field lives in its own contiguous column, and all
+ * columns grow in lockstep. Loops that only touch one field therefore read
+ * densely packed memory.
+ *
+ * Records are passed in and out in packed form: the fields laid out back to
+ * back in declaration order, without padding.
+ */
+typedef struct {
+    void **columns;
+    size_t *field_sizes;
+    size_t n_fields;
+    size_t record_size;
+    size_t len;
+    size_t cap;
+} collex_soa_t;
+
+/**
+ *  @brief Initializes a new struct-of-arrays container.
+ *  @param field_sizes Array holding the size of each field. No entry may be 0.
+ *  @param n_fields Number of fields in a record. Must not be 0.
+ *  @return Pointer to a newly allocated container instance or NULL on failure.
+ */
+collex_soa_t *collex_soa_init(const size_t *field_sizes, size_t n_fields);
+
+/**
+ *  @brief Frees all resources associated with the container.
+ *  @param soa Pointer to the container instance.
+ */
+void collex_soa_free(collex_soa_t *soa);
+
+/**
+ *  @brief Pushes a new record into the container.
+ *  @param soa Pointer to the container instance.
+ *  @param record Pointer to the packed record to be added.
+ *  @return 0 on success or -1 if memory allocation fails.
+ */
+int collex_soa_push(collex_soa_t *soa, const void *record);
+
+/**
+ *  @brief Copies the record at a specific index into a buffer.
+ *  @param soa Pointer to the container instance.
+ *  @param index Index of the record (0-based).
+ *  @param buffer Pointer to the memory where the packed record will be stored.
+ *  @return 0 on success or -1 if the index is out of range.
+ */
+int collex_soa_get(collex_soa_t *soa, size_t index, void *buffer);
+
+/**
+ *  @brief Retrieves the pointer to a single field of a record.
+ *  @param soa Pointer to the container instance.
+ *  @param index Index of the record (0-based).
+ *  @param field Index of the field (0-based).
+ *  @return Pointer to the field or NULL if either index is out of range.
+ */
+const void *collex_soa_get_field(collex_soa_t *soa, size_t index, size_t field);
+
+/**
+ *  @brief Retrieves the pointer to the start of a column.
+ *  The column holds len contiguous values and is invalidated by any call
+ *  that grows or reorders the container.
+ *  @param soa Pointer to the container instance.
+ *  @param field Index of the field (0-based).
+ *  @return Pointer to the column or NULL if the field is out of range.
+ */
+void *collex_soa_column(collex_soa_t *soa, size_t field);
+
+/**
+ *  @brief Sorts all records by the values in a key column.
+ *  The sort is stable. A permutation is computed from the key column and then
+ *  applied to every column.
+ *  @param soa Pointer to the container instance.
+ *  @param key Index of the field to sort by (0-based).
+ *  @param cmp Comparison function for values of the key field.
+ *  @return 0 on success or -1 if the key is out of range or memory allocation fails.
+ */
+int collex_soa_sort(collex_soa_t *soa, size_t key, int (*cmp)(void *x, void *y));
+
+#endif
@@ -0,0 +1,349 @@
+#include "collex_bitset.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define COLLEX_BITSET_X86 1
+#include <immintrin.h>
+#endif
+
+#define WORD_BITS 64
+#define SELECT_BLOCK_WORDS 64
+
+typedef struct {
+    void (*and)(uint64_t *dest, const uint64_t *src, size_t n);
+    void (*or)(uint64_t *dest, const uint64_t *src, size_t n);
+    void (*xor)(uint64_t *dest, const uint64_t *src, size_t n);
+    void (*andnot)(uint64_t *dest, const uint64_t *src, size_t n);
+    size_t (*popcount)(const uint64_t *words, size_t n);
+} bitset_kernels_t;
+
+static void scalar_and(uint64_t *dest, const uint64_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dest[i] &= src[i];
+    }
+}
+
+static void scalar_or(uint64_t *dest, const uint64_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dest[i] |= src[i];
+    }
+}
+
+static void scalar_xor(uint64_t *dest, const uint64_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dest[i] ^= src[i];
+    }
+}
+
+static void scalar_andnot(uint64_t *dest, const uint64_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dest[i] &= ~src[i];
+    }
+}
+
+static size_t scalar_popcount(const uint64_t *words, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += __builtin_popcountll(words[i]);
+    }
+    return count;
+}
+
+static const bitset_kernels_t scalar_kernels = {
+    scalar_and, scalar_or, scalar_xor, scalar_andnot, scalar_popcount,
+};
+
+#ifdef COLLEX_BITSET_X86
+__attribute__((target("popcnt"))) static size_t popcnt_popcount(const uint64_t *words, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += __builtin_popcountll(words[i]);
+    }
+    return count;
+}
+
+static const bitset_kernels_t popcnt_kernels = {
+    scalar_and, scalar_or, scalar_xor, scalar_andnot, popcnt_popcount,
+};
+
+#define AVX2_BINARY_KERNEL(name, expr)                                                                                 \
+    __attribute__((target("avx2"))) static void avx2_##name(uint64_t *dest, const uint64_t *src, size_t n) {           \
+        size_t i = 0;                                                                                                  \
+        for (; i + 4 <= n; i += 4) {                                                                                   \
+            __m256i a = _mm256_loadu_si256((const __m256i *)(dest + i));                                               \
+            __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));                                                \
+            _mm256_storeu_si256((__m256i *)(dest + i), expr);                                                          \
+        }                                                                                                              \
+        scalar_##name(dest + i, src + i, n - i);                                                                       \
+    }
+
+AVX2_BINARY_KERNEL(and, _mm256_and_si256(a, b))
+AVX2_BINARY_KERNEL(or, _mm256_or_si256(a, b))
+AVX2_BINARY_KERNEL(xor, _mm256_xor_si256(a, b))
+AVX2_BINARY_KERNEL(andnot, _mm256_andnot_si256(b, a))
+
+/* Nibble lookup popcount: each byte is split into two nibbles whose counts are
+ * looked up with a shuffle, then summed per 64-bit lane with SAD. */
+__attribute__((target("avx2,popcnt"))) static size_t avx2_popcount(const uint64_t *words, size_t n) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(words + i));
+        __m256i lo = _mm256_and_si256(v, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    size_t count = (size_t)_mm256_extract_epi64(acc, 0) + (size_t)_mm256_extract_epi64(acc, 1) +
+                   (size_t)_mm256_extract_epi64(acc, 2) + (size_t)_mm256_extract_epi64(acc, 3);
+    for (; i < n; i++) {
+        count += __builtin_popcountll(words[i]);
+    }
+    return count;
+}
+
+static const bitset_kernels_t avx2_kernels = {
+    avx2_and, avx2_or, avx2_xor, avx2_andnot, avx2_popcount,
+};
+#endif
+
+/* Picked once before main runs, so bulk operations only ever read it. */
+static const bitset_kernels_t *active_kernels = &scalar_kernels;
+
+static const bitset_kernels_t *kernels_for(collex_bitset_kernel_t kernel) {
+    switch (kernel) {
+    case COLLEX_BITSET_KERNEL_SCALAR:
+        return &scalar_kernels;
+#ifdef COLLEX_BITSET_X86
+    case COLLEX_BITSET_KERNEL_POPCNT:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt") ? &popcnt_kernels : NULL;
+    case COLLEX_BITSET_KERNEL_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") ? &avx2_kernels : NULL;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+__attribute__((constructor)) static void select_kernels(void) {
+    const bitset_kernels_t *picked = kernels_for(COLLEX_BITSET_KERNEL_AVX2);
+    if (!picked) {
+        picked = kernels_for(COLLEX_BITSET_KERNEL_POPCNT);
+    }
+    active_kernels = picked ? picked : &scalar_kernels;
+}
+
+int collex_bitset_use_kernel(collex_bitset_kernel_t kernel) {
+    const bitset_kernels_t *picked = kernels_for(kernel);
+    if (!picked) {
+        return -1;
+    }
+    active_kernels = picked;
+    return 0;
+}
+
+static size_t words_for(size_t len) { return (len + WORD_BITS - 1) / WORD_BITS; }
+
+static void clear_tail(collex_bitset_t *bitset) {
+    size_t used = bitset->len % WORD_BITS;
+    if (used) {
+        bitset->words[bitset->n_words - 1] &= ((uint64_t)1 << used) - 1;
+    }
+}
+
+collex_bitset_t *collex_bitset_init(size_t len) {
+    collex_bitset_t *bitset = malloc(sizeof(collex_bitset_t));
+    if (!bitset) {
+        return NULL;
+    }
+
+    bitset->len = len;
+    bitset->n_words = words_for(len);
+
+    bitset->words = calloc(bitset->n_words ? bitset->n_words : 1, sizeof(uint64_t));
+    if (!bitset->words) {
+        free(bitset);
+        return NULL;
+    }
+    return bitset;
+}
+
+void collex_bitset_free(collex_bitset_t *bitset) {
+    if (!bitset) {
+        return;
+    }
+
+    free(bitset->words);
+    bitset->words = NULL;
+
+    free(bitset);
+}
+
+int collex_bitset_resize(collex_bitset_t *bitset, size_t len) {
+    if (!bitset) {
+        return -1;
+    }
+
+    size_t n_words = words_for(len);
+    if (n_words != bitset->n_words) {
+        uint64_t *new_words = realloc(bitset->words, (n_words ? n_words : 1) * sizeof(uint64_t));
+        if (!new_words) {
+            return -1;
+        }
+        if (n_words > bitset->n_words) {
+            memset(new_words + bitset->n_words, 0, (n_words - bitset->n_words) * sizeof(uint64_t));
+        }
+        bitset->words = new_words;
+        bitset->n_words = n_words;
+    }
+
+    bitset->len = len;
+    clear_tail(bitset);
+    return 0;
+}
+
+int collex_bitset_set(collex_bitset_t *bitset, size_t index) {
+    if (!bitset || index >= bitset->len) {
+        return -1;
+    }
+    bitset->words[index / WORD_BITS] |= (uint64_t)1 << (index % WORD_BITS);
+    return 0;
+}
+
+int collex_bitset_clear(collex_bitset_t *bitset, size_t index) {
+    if (!bitset || index >= bitset->len) {
+        return -1;
+    }
+    bitset->words[index / WORD_BITS] &= ~((uint64_t)1 << (index % WORD_BITS));
+    return 0;
+}
+
+int collex_bitset_test(collex_bitset_t *bitset, size_t index) {
+    if (!bitset || index >= bitset->len) {
+        return -1;
+    }
+    return (bitset->words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+int collex_bitset_and(collex_bitset_t *dest, const collex_bitset_t *src) {
+    if (!dest || !src || dest->len != src->len) {
+        return -1;
+    }
+    active_kernels->and(dest->words, src->words, dest->n_words);
+    return 0;
+}
+
+int collex_bitset_or(collex_bitset_t *dest, const collex_bitset_t *src) {
+    if (!dest || !src || dest->len != src->len) {
+        return -1;
+    }
+    active_kernels->or(dest->words, src->words, dest->n_words);
+    return 0;
+}
+
+int collex_bitset_xor(collex_bitset_t *dest, const collex_bitset_t *src) {
+    if (!dest || !src || dest->len != src->len) {
+        return -1;
+    }
+    active_kernels->xor(dest->words, src->words, dest->n_words);
+    return 0;
+}
+
+int collex_bitset_andnot(collex_bitset_t *dest, const collex_bitset_t *src) {
+    if (!dest || !src || dest->len != src->len) {
+        return -1;
+    }
+    active_kernels->andnot(dest->words, src->words, dest->n_words);
+    return 0;
+}
+
+size_t collex_bitset_popcount(collex_bitset_t *bitset) {
+    if (!bitset) {
+        return 0;
+    }
+    return active_kernels->popcount(bitset->words, bitset->n_words);
+}
+
+int collex_bitset_find_first(collex_bitset_t *bitset, size_t *index) {
+    return collex_bitset_find_next(bitset, 0, index);
+}
+
+int collex_bitset_find_next(collex_bitset_t *bitset, size_t from, size_t *index) {
+    if (!bitset || !index || from >= bitset->len) {
+        return -1;
+    }
+
+    size_t w = from / WORD_BITS;
+    uint64_t word = bitset->words[w] & (~(uint64_t)0 << (from % WORD_BITS));
+    while (!word) {
+        if (++w == bitset->n_words) {
+            return -1;
+        }
+        word = bitset->words[w];
+    }
+
+    *index = w * WORD_BITS + __builtin_ctzll(word);
+    return 0;
+}
+
+size_t collex_bitset_rank(collex_bitset_t *bitset, size_t index) {
+    if (!bitset) {
+        return 0;
+    }
+
+    if (index > bitset->len) {
+        index = bitset->len;
+    }
+
+    size_t full = index / WORD_BITS;
+    size_t count = active_kernels->popcount(bitset->words, full);
+    size_t rest = index % WORD_BITS;
+    if (rest) {
+        count += __builtin_popcountll(bitset->words[full] & (((uint64_t)1 << rest) - 1));
+    }
+    return count;
+}
+
+int collex_bitset_select(collex_bitset_t *bitset, size_t k, size_t *index) {
+    if (!bitset || !index) {
+        return -1;
+    }
+
+    const bitset_kernels_t *ops = active_kernels;
+
+    /* Skip whole blocks with the vectorized popcount, then narrow down to
+     * the word and finally the bit holding the k-th set bit. */
+    size_t w = 0;
+    while (w + SELECT_BLOCK_WORDS <= bitset->n_words) {
+        size_t count = ops->popcount(bitset->words + w, SELECT_BLOCK_WORDS);
+        if (count > k) {
+            break;
+        }
+        k -= count;
+        w += SELECT_BLOCK_WORDS;
+    }
+
+    for (; w < bitset->n_words; w++) {
+        uint64_t word = bitset->words[w];
+        size_t count = __builtin_popcountll(word);
+        if (count > k) {
+            while (k--) {
+                word &= word - 1;
+            }
+            *index = w * WORD_BITS + __builtin_ctzll(word);
+            return 0;
+        }
+        k -= count;
+    }
+    return -1;
+}
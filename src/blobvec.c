@@ -0,0 +1,236 @@
+#include "collex_blobvec.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int reserve_spans(collex_blobvec_t *blobvec, size_t additional) {
+    if (blobvec->cap - blobvec->len >= additional) {
+        return 0;
+    }
+
+    size_t new_cap = blobvec->cap ? blobvec->cap : 1;
+    while (new_cap - blobvec->len < additional) {
+        new_cap *= 2;
+    }
+
+    collex_blobvec_span_t *new_spans = realloc(blobvec->spans, new_cap * sizeof(collex_blobvec_span_t));
+    if (!new_spans) {
+        return -1;
+    }
+    blobvec->spans = new_spans;
+    blobvec->cap = new_cap;
+    return 0;
+}
+
+static int reserve_data(collex_blobvec_t *blobvec, size_t additional) {
+    if (blobvec->data_cap - blobvec->data_len >= additional) {
+        return 0;
+    }
+
+    size_t new_cap = blobvec->data_cap ? blobvec->data_cap : 1;
+    while (new_cap - blobvec->data_len < additional) {
+        new_cap *= 2;
+    }
+
+    char *new_data = realloc(blobvec->data, new_cap);
+    if (!new_data) {
+        return -1;
+    }
+    blobvec->data = new_data;
+    blobvec->data_cap = new_cap;
+    return 0;
+}
+
+/* Tells whether value points into the arena, so callers can re-derive it
+ * after a reserve moves the buffer. Compared as integers because relational
+ * comparison of unrelated pointers is undefined. */
+static int arena_offset(const collex_blobvec_t *blobvec, const void *value, size_t *offset) {
+    uintptr_t start = (uintptr_t)blobvec->data;
+    uintptr_t addr = (uintptr_t)value;
+    if (!value || addr < start || addr >= start + blobvec->data_len) {
+        return 0;
+    }
+    *offset = addr - start;
+    return 1;
+}
+
+collex_blobvec_t *collex_blobvec_init(void) {
+    collex_blobvec_t *blobvec = malloc(sizeof(collex_blobvec_t));
+    if (!blobvec) {
+        return NULL;
+    }
+
+    blobvec->data_len = 0;
+    blobvec->data_cap = __COLLEX_BLOBVEC_INIT_DATA_CAP_;
+    blobvec->live = 0;
+    blobvec->len = 0;
+    blobvec->cap = __COLLEX_BLOBVEC_INIT_CAP_;
+
+    blobvec->data = malloc(blobvec->data_cap);
+    if (!blobvec->data) {
+        free(blobvec);
+        return NULL;
+    }
+
+    blobvec->spans = malloc(blobvec->cap * sizeof(collex_blobvec_span_t));
+    if (!blobvec->spans) {
+        free(blobvec->data);
+        free(blobvec);
+        return NULL;
+    }
+    return blobvec;
+}
+
+void collex_blobvec_free(collex_blobvec_t *blobvec) {
+    if (!blobvec) {
+        return;
+    }
+
+    free(blobvec->data);
+    blobvec->data = NULL;
+    free(blobvec->spans);
+    blobvec->spans = NULL;
+
+    free(blobvec);
+}
+
+int collex_blobvec_push(collex_blobvec_t *blobvec, const void *value, size_t len) {
+    if (!blobvec || (!value && len > 0)) {
+        return -1;
+    }
+
+    size_t offset;
+    int aliased = arena_offset(blobvec, value, &offset);
+    if (reserve_spans(blobvec, 1) == -1 || reserve_data(blobvec, len) == -1) {
+        return -1;
+    }
+    if (aliased) {
+        value = blobvec->data + offset;
+    }
+
+    if (len > 0) {
+        memcpy(blobvec->data + blobvec->data_len, value, len);
+    }
+    blobvec->spans[blobvec->len].offset = blobvec->data_len;
+    blobvec->spans[blobvec->len].len = len;
+    blobvec->data_len += len;
+    blobvec->live += len;
+    blobvec->len++;
+    return 0;
+}
+
+int collex_blobvec_append(collex_blobvec_t *blobvec, const void *values, const size_t *lens, size_t count) {
+    if (!blobvec || (count > 0 && !lens)) {
+        return -1;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += lens[i];
+    }
+    if (!values && total > 0) {
+        return -1;
+    }
+
+    size_t values_offset;
+    int aliased = arena_offset(blobvec, values, &values_offset);
+    if (reserve_spans(blobvec, count) == -1 || reserve_data(blobvec, total) == -1) {
+        return -1;
+    }
+    if (aliased) {
+        values = blobvec->data + values_offset;
+    }
+
+    if (total > 0) {
+        memcpy(blobvec->data + blobvec->data_len, values, total);
+    }
+
+    size_t offset = blobvec->data_len;
+    collex_blobvec_span_t *span = blobvec->spans + blobvec->len;
+    for (size_t i = 0; i < count; i++) {
+        span[i].offset = offset;
+        span[i].len = lens[i];
+        offset += lens[i];
+    }
+
+    blobvec->data_len += total;
+    blobvec->live += total;
+    blobvec->len += count;
+    return 0;
+}
+
+const void *collex_blobvec_get(collex_blobvec_t *blobvec, size_t index, size_t *len) {
+    if (!blobvec || index >= blobvec->len) {
+        return NULL;
+    }
+
+    collex_blobvec_span_t span = blobvec->spans[index];
+    if (len) {
+        *len = span.len;
+    }
+    return blobvec->data + span.offset;
+}
+
+int collex_blobvec_remove(collex_blobvec_t *blobvec, size_t index) {
+    if (!blobvec || index >= blobvec->len) {
+        return -1;
+    }
+
+    blobvec->live -= blobvec->spans[index].len;
+    memmove(blobvec->spans + index, blobvec->spans + index + 1,
+            (blobvec->len - index - 1) * sizeof(collex_blobvec_span_t));
+    blobvec->len--;
+
+    if (blobvec->len == 0) {
+        blobvec->data_len = 0;
+    } else if (index == blobvec->len) {
+        collex_blobvec_span_t last = blobvec->spans[blobvec->len - 1];
+        blobvec->data_len = last.offset + last.len;
+    }
+
+    /* Only compact once the unused bytes outweigh the live ones, so a run of
+     * removals costs amortized O(1) arena moves per byte. */
+    if (blobvec->data_len - blobvec->live > blobvec->live) {
+        collex_blobvec_compact(blobvec);
+    }
+    return 0;
+}
+
+int collex_blobvec_truncate(collex_blobvec_t *blobvec, size_t len) {
+    if (!blobvec || len > blobvec->len) {
+        return -1;
+    }
+
+    for (size_t i = len; i < blobvec->len; i++) {
+        blobvec->live -= blobvec->spans[i].len;
+    }
+    blobvec->len = len;
+
+    if (len == 0) {
+        blobvec->data_len = 0;
+    } else {
+        collex_blobvec_span_t last = blobvec->spans[len - 1];
+        blobvec->data_len = last.offset + last.len;
+    }
+    return 0;
+}
+
+void collex_blobvec_compact(collex_blobvec_t *blobvec) {
+    if (!blobvec || blobvec->data_len == blobvec->live) {
+        return;
+    }
+
+    /* Spans are always ordered by offset, so sliding each one down to the
+     * write cursor never overwrites bytes that are still to be moved. */
+    size_t cursor = 0;
+    for (size_t i = 0; i < blobvec->len; i++) {
+        collex_blobvec_span_t *span = blobvec->spans + i;
+        if (span->offset != cursor) {
+            memmove(blobvec->data + cursor, blobvec->data + span->offset, span->len);
+            span->offset = cursor;
+        }
+        cursor += span->len;
+    }
+    blobvec->data_len = cursor;
+}
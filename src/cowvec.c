@@ -0,0 +1,296 @@
+#include "collex_cowvec.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_LEN __COLLEX_COWVEC_CHUNK_LEN_
+
+static collex_cowvec_chunk_t *chunk_alloc(size_t elem_size) {
+    collex_cowvec_chunk_t *chunk = malloc(sizeof(collex_cowvec_chunk_t) + CHUNK_LEN * elem_size);
+    if (!chunk) {
+        return NULL;
+    }
+    chunk->refs = 1;
+    chunk->filled = 0;
+    return chunk;
+}
+
+static void chunk_release(collex_cowvec_chunk_t *chunk) {
+    if (chunk && --chunk->refs == 0) {
+        free(chunk);
+    }
+}
+
+static void snapshot_release(collex_cowvec_snapshot_t *snapshot) {
+    for (size_t c = 0; c < snapshot->n_chunks; c++) {
+        chunk_release(snapshot->chunks[c]);
+    }
+    free(snapshot->chunks);
+    free(snapshot);
+}
+
+/* Creates a new version sharing the first chunks of base. Slots past the
+ * chunks of base are left NULL for the caller to fill. */
+static collex_cowvec_snapshot_t *snapshot_derive(const collex_cowvec_snapshot_t *base, size_t len) {
+    collex_cowvec_snapshot_t *snapshot = malloc(sizeof(collex_cowvec_snapshot_t));
+    if (!snapshot) {
+        return NULL;
+    }
+
+    snapshot->len = len;
+    snapshot->elem_size = base->elem_size;
+    snapshot->n_chunks = (len + CHUNK_LEN - 1) / CHUNK_LEN;
+    snapshot->retired_at = 0;
+    snapshot->next_retired = NULL;
+    snapshot->chunks = NULL;
+
+    if (snapshot->n_chunks > 0) {
+        snapshot->chunks = calloc(snapshot->n_chunks, sizeof(collex_cowvec_chunk_t *));
+        if (!snapshot->chunks) {
+            free(snapshot);
+            return NULL;
+        }
+    }
+
+    size_t shared = base->n_chunks < snapshot->n_chunks ? base->n_chunks : snapshot->n_chunks;
+    for (size_t c = 0; c < shared; c++) {
+        snapshot->chunks[c] = base->chunks[c];
+        snapshot->chunks[c]->refs++;
+    }
+    return snapshot;
+}
+
+/* Makes chunk c of snapshot safe to write slots [0, used) and beyond. The
+ * chunk is replaced by a private copy unless every slot from used on has
+ * never been written by any version. */
+static int chunk_prepare(collex_cowvec_snapshot_t *snapshot, size_t c, size_t used, int overwrite) {
+    collex_cowvec_chunk_t *chunk = snapshot->chunks[c];
+    if (chunk && !overwrite && chunk->filled == used) {
+        return 0;
+    }
+
+    collex_cowvec_chunk_t *copy = chunk_alloc(snapshot->elem_size);
+    if (!copy) {
+        return -1;
+    }
+    if (chunk) {
+        memcpy(copy->data, chunk->data, used * snapshot->elem_size);
+    }
+    copy->filled = used;
+
+    chunk_release(chunk);
+    snapshot->chunks[c] = copy;
+    return 0;
+}
+
+static void publish(collex_cowvec_t *vector, collex_cowvec_snapshot_t *snapshot) {
+    collex_cowvec_snapshot_t *old = atomic_exchange(&vector->current, snapshot);
+    old->retired_at = atomic_fetch_add(&vector->epoch, 1);
+    old->next_retired = vector->retired;
+    vector->retired = old;
+    collex_cowvec_reclaim(vector);
+}
+
+collex_cowvec_t *collex_cowvec_init(size_t elem_size, size_t n_readers) {
+    if (elem_size == 0 || n_readers == 0) {
+        return NULL;
+    }
+
+    collex_cowvec_t *vector = malloc(sizeof(collex_cowvec_t));
+    if (!vector) {
+        return NULL;
+    }
+
+    collex_cowvec_snapshot_t *empty = malloc(sizeof(collex_cowvec_snapshot_t));
+    vector->readers = malloc(n_readers * sizeof(collex_cowvec_reader_t));
+    if (!empty || !vector->readers) {
+        free(empty);
+        free(vector->readers);
+        free(vector);
+        return NULL;
+    }
+
+    empty->len = 0;
+    empty->elem_size = elem_size;
+    empty->n_chunks = 0;
+    empty->chunks = NULL;
+    empty->retired_at = 0;
+    empty->next_retired = NULL;
+
+    vector->elem_size = elem_size;
+    vector->n_readers = n_readers;
+    vector->retired = NULL;
+    atomic_init(&vector->current, empty);
+    atomic_init(&vector->epoch, 1);
+    for (size_t r = 0; r < n_readers; r++) {
+        atomic_init(&vector->readers[r].epoch, 0);
+    }
+    return vector;
+}
+
+void collex_cowvec_free(collex_cowvec_t *vector) {
+    if (!vector) {
+        return;
+    }
+
+    collex_cowvec_snapshot_t *retired = vector->retired;
+    while (retired) {
+        collex_cowvec_snapshot_t *next = retired->next_retired;
+        snapshot_release(retired);
+        retired = next;
+    }
+    snapshot_release(atomic_load(&vector->current));
+
+    free(vector->readers);
+    vector->readers = NULL;
+
+    free(vector);
+}
+
+const collex_cowvec_snapshot_t *collex_cowvec_read_begin(collex_cowvec_t *vector, size_t reader) {
+    if (!vector || reader >= vector->n_readers) {
+        return NULL;
+    }
+
+    /* The announcement must be visible before the version is loaded; the
+     * writer checks announcements only after swapping the version out. */
+    atomic_store(&vector->readers[reader].epoch, atomic_load(&vector->epoch));
+    return atomic_load(&vector->current);
+}
+
+void collex_cowvec_read_end(collex_cowvec_t *vector, size_t reader) {
+    if (!vector || reader >= vector->n_readers) {
+        return;
+    }
+    atomic_store_explicit(&vector->readers[reader].epoch, 0, memory_order_release);
+}
+
+const void *collex_cowvec_snapshot_get(const collex_cowvec_snapshot_t *snapshot, size_t index) {
+    if (!snapshot || index >= snapshot->len) {
+        return NULL;
+    }
+    return snapshot->chunks[index / CHUNK_LEN]->data + (index % CHUNK_LEN) * snapshot->elem_size;
+}
+
+int collex_cowvec_set(collex_cowvec_t *vector, size_t index, const void *value) {
+    if (!vector || !value) {
+        return -1;
+    }
+
+    collex_cowvec_snapshot_t *base = atomic_load(&vector->current);
+    if (index >= base->len) {
+        return -1;
+    }
+
+    collex_cowvec_snapshot_t *snapshot = snapshot_derive(base, base->len);
+    if (!snapshot) {
+        return -1;
+    }
+
+    size_t c = index / CHUNK_LEN;
+    size_t used = c + 1 < snapshot->n_chunks ? CHUNK_LEN : base->len - c * CHUNK_LEN;
+    if (chunk_prepare(snapshot, c, used, 1) == -1) {
+        snapshot_release(snapshot);
+        return -1;
+    }
+
+    memcpy(snapshot->chunks[c]->data + (index % CHUNK_LEN) * vector->elem_size, value, vector->elem_size);
+    publish(vector, snapshot);
+    return 0;
+}
+
+int collex_cowvec_push(collex_cowvec_t *vector, const void *value) {
+    return collex_cowvec_append(vector, value, 1);
+}
+
+int collex_cowvec_append(collex_cowvec_t *vector, const void *values, size_t count) {
+    if (!vector || !values) {
+        return -1;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    collex_cowvec_snapshot_t *base = atomic_load(&vector->current);
+    collex_cowvec_snapshot_t *snapshot = snapshot_derive(base, base->len + count);
+    if (!snapshot) {
+        return -1;
+    }
+
+    const char *src = values;
+    size_t index = base->len;
+    while (index < snapshot->len) {
+        size_t c = index / CHUNK_LEN;
+        size_t used = index % CHUNK_LEN;
+        if (chunk_prepare(snapshot, c, used, 0) == -1) {
+            snapshot_release(snapshot);
+            return -1;
+        }
+
+        collex_cowvec_chunk_t *chunk = snapshot->chunks[c];
+        size_t n = CHUNK_LEN - used;
+        if (n > snapshot->len - index) {
+            n = snapshot->len - index;
+        }
+        memcpy(chunk->data + used * vector->elem_size, src, n * vector->elem_size);
+        chunk->filled = used + n;
+
+        src += n * vector->elem_size;
+        index += n;
+    }
+
+    publish(vector, snapshot);
+    return 0;
+}
+
+int collex_cowvec_pop(collex_cowvec_t *vector, void *buffer) {
+    if (!vector) {
+        return -1;
+    }
+
+    collex_cowvec_snapshot_t *base = atomic_load(&vector->current);
+    if (base->len == 0) {
+        return -1;
+    }
+
+    collex_cowvec_snapshot_t *snapshot = snapshot_derive(base, base->len - 1);
+    if (!snapshot) {
+        return -1;
+    }
+
+    if (buffer) {
+        memcpy(buffer, collex_cowvec_snapshot_get(base, base->len - 1), vector->elem_size);
+    }
+    publish(vector, snapshot);
+    return 0;
+}
+
+void collex_cowvec_reclaim(collex_cowvec_t *vector) {
+    if (!vector) {
+        return;
+    }
+
+    uint64_t oldest = UINT64_MAX;
+    for (size_t r = 0; r < vector->n_readers; r++) {
+        uint64_t epoch = atomic_load(&vector->readers[r].epoch);
+        if (epoch && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    /* A version retired at epoch e can only be held by readers that
+     * announced an epoch of e or earlier. */
+    collex_cowvec_snapshot_t **link = &vector->retired;
+    while (*link) {
+        collex_cowvec_snapshot_t *retired = *link;
+        if (retired->retired_at < oldest) {
+            *link = retired->next_retired;
+            snapshot_release(retired);
+        } else {
+            link = &retired->next_retired;
+        }
+    }
+}
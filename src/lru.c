@@ -0,0 +1,261 @@
+#include "collex_lru.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scrambles the user hash so that weak hashes (e.g. identity on integers)
+ * still spread evenly over a power-of-two table. */
+static size_t mix(size_t hash) {
+    uint64_t x = hash;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return (size_t)x;
+}
+
+static size_t hash_key(collex_lru_t *lru, const void *key) {
+    if (lru->hash) {
+        return mix(lru->hash(key));
+    }
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const unsigned char *bytes = key;
+    for (size_t i = 0; i < lru->key_size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return mix((size_t)hash);
+}
+
+static int keys_equal(collex_lru_t *lru, const void *x, const void *y) {
+    if (lru->compare) {
+        return lru->compare((void *)x, (void *)y) == 0;
+    }
+    return memcmp(x, y, lru->key_size) == 0;
+}
+
+static size_t find_slot(collex_lru_t *lru, const void *key, size_t hash) {
+    size_t slot = hash & lru->index_mask;
+    while (lru->index[slot]) {
+        collex_lru_node_t *node = lru->index[slot];
+        if (node->hash == hash && keys_equal(lru, node->key, key)) {
+            return slot;
+        }
+        slot = (slot + 1) & lru->index_mask;
+    }
+    return slot;
+}
+
+/* Backward-shift deletion keeps probe chains intact without tombstones. */
+static void unindex(collex_lru_t *lru, collex_lru_node_t *node) {
+    size_t hole = node->hash & lru->index_mask;
+    while (lru->index[hole] != node) {
+        hole = (hole + 1) & lru->index_mask;
+    }
+
+    size_t slot = hole;
+    for (;;) {
+        slot = (slot + 1) & lru->index_mask;
+        collex_lru_node_t *next = lru->index[slot];
+        if (!next) {
+            break;
+        }
+
+        size_t home = next->hash & lru->index_mask;
+        if (((slot - home) & lru->index_mask) >= ((slot - hole) & lru->index_mask)) {
+            lru->index[hole] = next;
+            hole = slot;
+        }
+    }
+    lru->index[hole] = NULL;
+}
+
+static void unlink_node(collex_lru_t *lru, collex_lru_node_t *node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        lru->head = node->next;
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        lru->tail = node->prev;
+    }
+}
+
+static void push_front(collex_lru_t *lru, collex_lru_node_t *node) {
+    node->prev = NULL;
+    node->next = lru->head;
+    if (lru->head) {
+        lru->head->prev = node;
+    } else {
+        lru->tail = node;
+    }
+    lru->head = node;
+}
+
+static void drop(collex_lru_t *lru, collex_lru_node_t *node) {
+    unindex(lru, node);
+    unlink_node(lru, node);
+    if (lru->release) {
+        lru->release(node->value);
+    }
+
+    node->next = lru->unused;
+    lru->unused = node;
+    lru->len--;
+}
+
+collex_lru_t *collex_lru_init(size_t cap, size_t key_size, size_t value_size, size_t (*hash)(const void *),
+                              int (*compare)(void *, void *), void (*release)(void *)) {
+    if (cap == 0 || key_size == 0) {
+        return NULL;
+    }
+
+    collex_lru_t *lru = malloc(sizeof(collex_lru_t));
+    if (!lru) {
+        return NULL;
+    }
+
+    size_t index_cap = 1;
+    while (index_cap < cap * 2) {
+        index_cap *= 2;
+    }
+
+    lru->len = 0;
+    lru->cap = cap;
+    lru->key_size = key_size;
+    lru->value_size = value_size;
+    lru->head = NULL;
+    lru->tail = NULL;
+    lru->index_mask = index_cap - 1;
+    lru->hash = hash;
+    lru->compare = compare;
+    lru->release = release;
+
+    lru->nodes = malloc(cap * sizeof(collex_lru_node_t));
+    lru->keys = malloc(cap * key_size);
+    lru->values = malloc(value_size ? cap * value_size : 1);
+    lru->index = calloc(index_cap, sizeof(collex_lru_node_t *));
+    if (!lru->nodes || !lru->keys || !lru->values || !lru->index) {
+        collex_lru_free(lru);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < cap; i++) {
+        lru->nodes[i].key = lru->keys + i * key_size;
+        lru->nodes[i].value = lru->values + i * value_size;
+        lru->nodes[i].next = i + 1 < cap ? &lru->nodes[i + 1] : NULL;
+    }
+    lru->unused = lru->nodes;
+    return lru;
+}
+
+void collex_lru_free(collex_lru_t *lru) {
+    if (!lru) {
+        return;
+    }
+
+    if (lru->release) {
+        for (collex_lru_node_t *node = lru->head; node; node = node->next) {
+            lru->release(node->value);
+        }
+    }
+
+    free(lru->nodes);
+    free(lru->keys);
+    free(lru->values);
+    free(lru->index);
+    free(lru);
+}
+
+void *collex_lru_get(collex_lru_t *lru, const void *key) {
+    if (!lru || !key) {
+        return NULL;
+    }
+
+    collex_lru_node_t *node = lru->index[find_slot(lru, key, hash_key(lru, key))];
+    if (!node) {
+        return NULL;
+    }
+
+    if (node != lru->head) {
+        unlink_node(lru, node);
+        push_front(lru, node);
+    }
+    return node->value;
+}
+
+void *collex_lru_peek(collex_lru_t *lru, const void *key) {
+    if (!lru || !key) {
+        return NULL;
+    }
+
+    collex_lru_node_t *node = lru->index[find_slot(lru, key, hash_key(lru, key))];
+    return node ? node->value : NULL;
+}
+
+int collex_lru_put(collex_lru_t *lru, const void *key, const void *value) {
+    if (!lru || !key || (!value && lru->value_size > 0)) {
+        return -1;
+    }
+
+    size_t hash = hash_key(lru, key);
+    size_t slot = find_slot(lru, key, hash);
+    collex_lru_node_t *node = lru->index[slot];
+
+    if (node) {
+        if (lru->release) {
+            lru->release(node->value);
+        }
+        if (node != lru->head) {
+            unlink_node(lru, node);
+            push_front(lru, node);
+        }
+    } else {
+        if (lru->len == lru->cap) {
+            drop(lru, lru->tail);
+            slot = find_slot(lru, key, hash);
+        }
+
+        node = lru->unused;
+        lru->unused = node->next;
+        memcpy(node->key, key, lru->key_size);
+        node->hash = hash;
+        lru->index[slot] = node;
+        push_front(lru, node);
+        lru->len++;
+    }
+
+    if (lru->value_size > 0) {
+        memcpy(node->value, value, lru->value_size);
+    }
+    return 0;
+}
+
+int collex_lru_remove(collex_lru_t *lru, const void *key) {
+    if (!lru || !key) {
+        return -1;
+    }
+
+    collex_lru_node_t *node = lru->index[find_slot(lru, key, hash_key(lru, key))];
+    if (!node) {
+        return -1;
+    }
+
+    drop(lru, node);
+    return 0;
+}
+
+int collex_lru_evict(collex_lru_t *lru) {
+    if (!lru || !lru->tail) {
+        return -1;
+    }
+
+    drop(lru, lru->tail);
+    return 0;
+}
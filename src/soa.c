@@ -0,0 +1,210 @@
+#include "collex_soa.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int reallocate_columns(collex_soa_t *soa, size_t n_records) {
+    for (size_t f = 0; f < soa->n_fields; f++) {
+        void *new_column = realloc(soa->columns[f], n_records * soa->field_sizes[f]);
+        if (!new_column) {
+            /* Columns already grown keep their larger buffers; cap only
+             * advances once every column fits n_records. */
+            return -1;
+        }
+        soa->columns[f] = new_column;
+    }
+    soa->cap = n_records;
+    return 0;
+}
+
+collex_soa_t *collex_soa_init(const size_t *field_sizes, size_t n_fields) {
+    if (!field_sizes || n_fields == 0) {
+        return NULL;
+    }
+
+    size_t record_size = 0;
+    for (size_t f = 0; f < n_fields; f++) {
+        if (field_sizes[f] == 0) {
+            return NULL;
+        }
+        record_size += field_sizes[f];
+    }
+
+    collex_soa_t *soa = malloc(sizeof(collex_soa_t));
+    if (!soa) {
+        return NULL;
+    }
+
+    soa->n_fields = n_fields;
+    soa->record_size = record_size;
+    soa->len = 0;
+    soa->cap = 0;
+
+    soa->field_sizes = malloc(n_fields * sizeof(size_t));
+    soa->columns = calloc(n_fields, sizeof(void *));
+    if (!soa->field_sizes || !soa->columns) {
+        free(soa->field_sizes);
+        free(soa->columns);
+        free(soa);
+        return NULL;
+    }
+    memcpy(soa->field_sizes, field_sizes, n_fields * sizeof(size_t));
+
+    if (reallocate_columns(soa, __COLLEX_SOA_INIT_CAP_) == -1) {
+        collex_soa_free(soa);
+        return NULL;
+    }
+    return soa;
+}
+
+void collex_soa_free(collex_soa_t *soa) {
+    if (!soa) {
+        return;
+    }
+
+    for (size_t f = 0; f < soa->n_fields; f++) {
+        free(soa->columns[f]);
+    }
+    free(soa->columns);
+    soa->columns = NULL;
+    free(soa->field_sizes);
+    soa->field_sizes = NULL;
+
+    free(soa);
+}
+
+int collex_soa_push(collex_soa_t *soa, const void *record) {
+    if (!soa || !record) {
+        return -1;
+    }
+
+    if (soa->len == soa->cap) {
+        if (reallocate_columns(soa, soa->cap ? soa->cap * 2 : 1) == -1) {
+            return -1;
+        }
+    }
+
+    const char *src = record;
+    for (size_t f = 0; f < soa->n_fields; f++) {
+        size_t size = soa->field_sizes[f];
+        memcpy((char *)soa->columns[f] + soa->len * size, src, size);
+        src += size;
+    }
+    soa->len++;
+    return 0;
+}
+
+int collex_soa_get(collex_soa_t *soa, size_t index, void *buffer) {
+    if (!soa || !buffer || index >= soa->len) {
+        return -1;
+    }
+
+    char *dest = buffer;
+    for (size_t f = 0; f < soa->n_fields; f++) {
+        size_t size = soa->field_sizes[f];
+        memcpy(dest, (char *)soa->columns[f] + index * size, size);
+        dest += size;
+    }
+    return 0;
+}
+
+const void *collex_soa_get_field(collex_soa_t *soa, size_t index, size_t field) {
+    if (!soa || index >= soa->len || field >= soa->n_fields) {
+        return NULL;
+    }
+    return (char *)soa->columns[field] + index * soa->field_sizes[field];
+}
+
+void *collex_soa_column(collex_soa_t *soa, size_t field) {
+    if (!soa || field >= soa->n_fields) {
+        return NULL;
+    }
+    return soa->columns[field];
+}
+
+static void merge_sort(size_t *perm, size_t *scratch, size_t n, const char *keys, size_t key_size,
+                       int (*cmp)(void *, void *)) {
+    if (n < 2) {
+        return;
+    }
+
+    size_t mid = n / 2;
+    merge_sort(perm, scratch, mid, keys, key_size, cmp);
+    merge_sort(perm + mid, scratch, n - mid, keys, key_size, cmp);
+
+    size_t i = 0, j = mid, k = 0;
+    while (i < mid && j < n) {
+        void *x = (void *)(keys + perm[j] * key_size);
+        void *y = (void *)(keys + perm[i] * key_size);
+        scratch[k++] = cmp(x, y) < 0 ? perm[j++] : perm[i++];
+    }
+    while (i < mid) {
+        scratch[k++] = perm[i++];
+    }
+    while (j < n) {
+        scratch[k++] = perm[j++];
+    }
+    memcpy(perm, scratch, n * sizeof(size_t));
+}
+
+int collex_soa_sort(collex_soa_t *soa, size_t key, int (*cmp)(void *x, void *y)) {
+    if (!soa || !cmp || key >= soa->n_fields) {
+        return -1;
+    }
+
+    if (soa->len < 2) {
+        return 0;
+    }
+
+    size_t *order = malloc(soa->n_fields * sizeof(size_t));
+    size_t *perm = malloc(soa->len * sizeof(size_t));
+    size_t *scratch = malloc(soa->len * sizeof(size_t));
+    if (!order || !perm || !scratch) {
+        free(order);
+        free(perm);
+        free(scratch);
+        return -1;
+    }
+
+    /* Columns are visited from the widest field down so that each replaced
+     * column is always large enough to serve as the spare for the next one. */
+    for (size_t f = 0; f < soa->n_fields; f++) {
+        size_t g = f;
+        while (g > 0 && soa->field_sizes[order[g - 1]] < soa->field_sizes[f]) {
+            order[g] = order[g - 1];
+            g--;
+        }
+        order[g] = f;
+    }
+
+    char *spare = malloc(soa->cap * soa->field_sizes[order[0]]);
+    if (!spare) {
+        free(order);
+        free(perm);
+        free(scratch);
+        return -1;
+    }
+
+    for (size_t i = 0; i < soa->len; i++) {
+        perm[i] = i;
+    }
+    merge_sort(perm, scratch, soa->len, soa->columns[key], soa->field_sizes[key], cmp);
+    free(scratch);
+
+    for (size_t o = 0; o < soa->n_fields; o++) {
+        size_t f = order[o];
+        size_t size = soa->field_sizes[f];
+        const char *src = soa->columns[f];
+        for (size_t i = 0; i < soa->len; i++) {
+            memcpy(spare + i * size, src + perm[i] * size, size);
+        }
+
+        soa->columns[f] = spare;
+        spare = (char *)src;
+    }
+
+    free(spare);
+    free(order);
+    free(perm);
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include "collex_bitset.h"
+#include <assert.h>
+#include <stdio.h>
+
+void test_bitset_init_free() {
+    collex_bitset_t *bitset = collex_bitset_init(130);
+    assert(bitset != NULL);
+    assert(bitset->len == 130);
+    assert(bitset->n_words == 3);
+    assert(collex_bitset_popcount(bitset) == 0);
+    collex_bitset_free(bitset);
+
+    bitset = collex_bitset_init(0);
+    assert(bitset != NULL);
+    assert(collex_bitset_popcount(bitset) == 0);
+    collex_bitset_free(bitset);
+    printf("test_bitset_init_free passed\n");
+}
+
+void test_bitset_set_clear_test() {
+    collex_bitset_t *bitset = collex_bitset_init(100);
+    assert(collex_bitset_set(bitset, 0) == 0);
+    assert(collex_bitset_set(bitset, 63) == 0);
+    assert(collex_bitset_set(bitset, 64) == 0);
+    assert(collex_bitset_set(bitset, 99) == 0);
+    assert(collex_bitset_set(bitset, 100) == -1);
+    assert(collex_bitset_test(bitset, 63) == 1);
+    assert(collex_bitset_test(bitset, 62) == 0);
+    assert(collex_bitset_test(bitset, 100) == -1);
+    assert(collex_bitset_clear(bitset, 63) == 0);
+    assert(collex_bitset_test(bitset, 63) == 0);
+    assert(collex_bitset_clear(bitset, 100) == -1);
+    assert(collex_bitset_popcount(bitset) == 3);
+    collex_bitset_free(bitset);
+    printf("test_bitset_set_clear_test passed\n");
+}
+
+void test_bitset_resize() {
+    collex_bitset_t *bitset = collex_bitset_init(70);
+    collex_bitset_set(bitset, 5);
+    collex_bitset_set(bitset, 69);
+    assert(collex_bitset_resize(bitset, 66) == 0);
+    assert(collex_bitset_popcount(bitset) == 1);
+    assert(collex_bitset_resize(bitset, 300) == 0);
+    assert(collex_bitset_test(bitset, 69) == 0);
+    assert(collex_bitset_test(bitset, 5) == 1);
+    assert(collex_bitset_popcount(bitset) == 1);
+    collex_bitset_free(bitset);
+    printf("test_bitset_resize passed\n");
+}
+
+void test_bitset_boolean_ops() {
+    size_t len = 1000;
+    collex_bitset_t *a = collex_bitset_init(len);
+    collex_bitset_t *b = collex_bitset_init(len);
+    collex_bitset_t *other = collex_bitset_init(len + 1);
+    for (size_t i = 0; i < len; i++) {
+        if (i % 2 == 0) {
+            collex_bitset_set(a, i);
+        }
+        if (i % 3 == 0) {
+            collex_bitset_set(b, i);
+        }
+    }
+
+    assert(collex_bitset_and(a, other) == -1);
+
+    assert(collex_bitset_or(a, b) == 0);
+    for (size_t i = 0; i < len; i++) {
+        assert(collex_bitset_test(a, i) == (i % 2 == 0 || i % 3 == 0));
+    }
+    assert(collex_bitset_andnot(a, b) == 0);
+    for (size_t i = 0; i < len; i++) {
+        assert(collex_bitset_test(a, i) == (i % 2 == 0 && i % 3 != 0));
+    }
+    assert(collex_bitset_xor(a, b) == 0);
+    for (size_t i = 0; i < len; i++) {
+        assert(collex_bitset_test(a, i) == (i % 2 == 0 || i % 3 == 0));
+    }
+    assert(collex_bitset_and(a, b) == 0);
+    for (size_t i = 0; i < len; i++) {
+        assert(collex_bitset_test(a, i) == (i % 3 == 0));
+    }
+    assert(collex_bitset_popcount(a) == 334);
+
+    collex_bitset_free(a);
+    collex_bitset_free(b);
+    collex_bitset_free(other);
+    printf("test_bitset_boolean_ops passed\n");
+}
+
+void test_bitset_find() {
+    collex_bitset_t *bitset = collex_bitset_init(500);
+    size_t index;
+    assert(collex_bitset_find_first(bitset, &index) == -1);
+    collex_bitset_set(bitset, 3);
+    collex_bitset_set(bitset, 200);
+    collex_bitset_set(bitset, 499);
+    assert(collex_bitset_find_first(bitset, &index) == 0 && index == 3);
+    assert(collex_bitset_find_next(bitset, 3, &index) == 0 && index == 3);
+    assert(collex_bitset_find_next(bitset, 4, &index) == 0 && index == 200);
+    assert(collex_bitset_find_next(bitset, 201, &index) == 0 && index == 499);
+    assert(collex_bitset_find_next(bitset, 500, &index) == -1);
+    collex_bitset_clear(bitset, 499);
+    assert(collex_bitset_find_next(bitset, 201, &index) == -1);
+    collex_bitset_free(bitset);
+    printf("test_bitset_find passed\n");
+}
+
+void test_bitset_rank_select() {
+    size_t len = 10000;
+    collex_bitset_t *bitset = collex_bitset_init(len);
+    for (size_t i = 0; i < len; i += 7) {
+        collex_bitset_set(bitset, i);
+    }
+    size_t total = collex_bitset_popcount(bitset);
+    assert(total == (len + 6) / 7);
+
+    for (size_t i = 0; i <= len; i += 13) {
+        assert(collex_bitset_rank(bitset, i) == (i + 6) / 7);
+    }
+    assert(collex_bitset_rank(bitset, len + 100) == total);
+
+    size_t index;
+    for (size_t k = 0; k < total; k++) {
+        assert(collex_bitset_select(bitset, k, &index) == 0);
+        assert(index == k * 7);
+        assert(collex_bitset_rank(bitset, index) == k);
+    }
+    assert(collex_bitset_select(bitset, total, &index) == -1);
+    collex_bitset_free(bitset);
+    printf("test_bitset_rank_select passed\n");
+}
+
+void test_bitset_each_kernel() {
+    collex_bitset_kernel_t kernels[] = {COLLEX_BITSET_KERNEL_SCALAR, COLLEX_BITSET_KERNEL_POPCNT,
+                                        COLLEX_BITSET_KERNEL_AVX2};
+    const char *names[] = {"scalar", "popcnt", "avx2"};
+
+    assert(collex_bitset_use_kernel(COLLEX_BITSET_KERNEL_SCALAR) == 0);
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        if (collex_bitset_use_kernel(kernels[i]) == -1) {
+            printf("test_bitset_each_kernel: %s kernel not supported, skipped\n", names[i]);
+            continue;
+        }
+        printf("test_bitset_each_kernel: using %s kernel\n", names[i]);
+        test_bitset_boolean_ops();
+        test_bitset_rank_select();
+    }
+    printf("test_bitset_each_kernel passed\n");
+}
+
+int main() {
+    test_bitset_init_free();
+    test_bitset_set_clear_test();
+    test_bitset_resize();
+    test_bitset_boolean_ops();
+    test_bitset_find();
+    test_bitset_rank_select();
+    test_bitset_each_kernel();
+    printf("All bitset tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "collex_blobvec.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+static int blob_eq(collex_blobvec_t *blobvec, size_t index, const char *expected) {
+    size_t len;
+    const char *value = collex_blobvec_get(blobvec, index, &len);
+    return value && len == strlen(expected) && memcmp(value, expected, len) == 0;
+}
+
+void test_blobvec_init_free() {
+    collex_blobvec_t *blobvec = collex_blobvec_init();
+    assert(blobvec != NULL);
+    assert(blobvec->len == 0);
+    assert(blobvec->data_len == 0);
+    collex_blobvec_free(blobvec);
+    printf("test_blobvec_init_free passed\n");
+}
+
+void test_blobvec_push_get() {
+    collex_blobvec_t *blobvec = collex_blobvec_init();
+    assert(collex_blobvec_push(blobvec, "alpha", 5) == 0);
+    assert(collex_blobvec_push(blobvec, NULL, 0) == 0);
+    assert(collex_blobvec_push(blobvec, "gamma", 5) == 0);
+    assert(blobvec->len == 3);
+    assert(blob_eq(blobvec, 0, "alpha"));
+    assert(blob_eq(blobvec, 1, ""));
+    assert(blob_eq(blobvec, 2, "gamma"));
+    assert(collex_blobvec_get(blobvec, 3, NULL) == NULL);
+    assert(collex_blobvec_push(blobvec, NULL, 1) == -1);
+
+    for (int i = 0; i < 1000; i++) {
+        char buf[16];
+        int n = sprintf(buf, "item-%d", i);
+        assert(collex_blobvec_push(blobvec, buf, n) == 0);
+    }
+    assert(blob_eq(blobvec, 3, "item-0"));
+    assert(blob_eq(blobvec, 1002, "item-999"));
+    collex_blobvec_free(blobvec);
+    printf("test_blobvec_push_get passed\n");
+}
+
+void test_blobvec_append() {
+    collex_blobvec_t *blobvec = collex_blobvec_init();
+    const char *values = "onetwothree";
+    size_t lens[] = {3, 3, 5};
+    assert(collex_blobvec_push(blobvec, "zero", 4) == 0);
+    assert(collex_blobvec_append(blobvec, values, lens, 3) == 0);
+    assert(blobvec->len == 4);
+    assert(blob_eq(blobvec, 0, "zero"));
+    assert(blob_eq(blobvec, 1, "one"));
+    assert(blob_eq(blobvec, 2, "two"));
+    assert(blob_eq(blobvec, 3, "three"));
+    assert(collex_blobvec_append(blobvec, NULL, NULL, 0) == 0);
+    assert(blobvec->len == 4);
+    collex_blobvec_free(blobvec);
+    printf("test_blobvec_append passed\n");
+}
+
+void test_blobvec_truncate() {
+    collex_blobvec_t *blobvec = collex_blobvec_init();
+    collex_blobvec_push(blobvec, "a", 1);
+    collex_blobvec_push(blobvec, "bb", 2);
+    collex_blobvec_push(blobvec, "ccc", 3);
+    assert(collex_blobvec_truncate(blobvec, 4) == -1);
+    assert(collex_blobvec_truncate(blobvec, 1) == 0);
+    assert(blobvec->len == 1);
+    assert(blobvec->data_len == 1);
+    assert(blob_eq(blobvec, 0, "a"));
+    collex_blobvec_push(blobvec, "dd", 2);
+    assert(blob_eq(blobvec, 1, "dd"));
+    assert(collex_blobvec_truncate(blobvec, 0) == 0);
+    assert(blobvec->len == 0 && blobvec->data_len == 0);
+    collex_blobvec_free(blobvec);
+    printf("test_blobvec_truncate passed\n");
+}
+
+void test_blobvec_remove_compact() {
+    collex_blobvec_t *blobvec = collex_blobvec_init();
+    collex_blobvec_push(blobvec, "first", 5);
+    collex_blobvec_push(blobvec, "second", 6);
+    collex_blobvec_push(blobvec, "third", 5);
+    collex_blobvec_push(blobvec, "fourth", 6);
+
+    assert(collex_blobvec_remove(blobvec, 1) == 0);
+    assert(blobvec->len == 3);
+    assert(blobvec->data_len == 22);
+    assert(blob_eq(blobvec, 0, "first"));
+    assert(blob_eq(blobvec, 1, "third"));
+    assert(blob_eq(blobvec, 2, "fourth"));
+
+    collex_blobvec_compact(blobvec);
+    assert(blobvec->data_len == 16);
+    assert(blob_eq(blobvec, 1, "third"));
+    assert(blob_eq(blobvec, 2, "fourth"));
+
+    assert(collex_blobvec_remove(blobvec, 0) == 0);
+    assert(collex_blobvec_remove(blobvec, 0) == 0);
+    assert(blobvec->data_len == blobvec->live);
+    assert(blob_eq(blobvec, 0, "fourth"));
+    assert(collex_blobvec_remove(blobvec, 1) == -1);
+    assert(collex_blobvec_remove(blobvec, 0) == 0);
+    assert(blobvec->len == 0 && blobvec->data_len == 0);
+    collex_blobvec_free(blobvec);
+    printf("test_blobvec_remove_compact passed\n");
+}
+
+void test_blobvec_push_self() {
+    collex_blobvec_t *blobvec = collex_blobvec_init();
+    char big[60];
+    memset(big, 'x', sizeof(big));
+    assert(collex_blobvec_push(blobvec, big, sizeof(big)) == 0);
+
+    for (int i = 0; i < 4; i++) {
+        size_t len;
+        const void *value = collex_blobvec_get(blobvec, i, &len);
+        assert(collex_blobvec_push(blobvec, value, len) == 0);
+    }
+    assert(blobvec->data_cap > __COLLEX_BLOBVEC_INIT_DATA_CAP_);
+    for (size_t i = 0; i < 5; i++) {
+        size_t len;
+        const char *value = collex_blobvec_get(blobvec, i, &len);
+        assert(len == sizeof(big) && memcmp(value, big, len) == 0);
+    }
+
+    size_t lens[] = {60, 60, 60};
+    size_t old_len = blobvec->len;
+    assert(collex_blobvec_append(blobvec, collex_blobvec_get(blobvec, 1, NULL), lens, 3) == 0);
+    for (size_t i = old_len; i < blobvec->len; i++) {
+        size_t len;
+        const char *value = collex_blobvec_get(blobvec, i, &len);
+        assert(len == sizeof(big) && memcmp(value, big, len) == 0);
+    }
+    collex_blobvec_free(blobvec);
+    printf("test_blobvec_push_self passed\n");
+}
+
+int main() {
+    test_blobvec_init_free();
+    test_blobvec_push_get();
+    test_blobvec_append();
+    test_blobvec_truncate();
+    test_blobvec_remove_compact();
+    test_blobvec_push_self();
+    printf("All blobvec tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,244 @@
+#include "collex_cowvec.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define N_THREAD_READERS 4
+#define N_THREAD_WRITES 20000
+#define THREAD_BASE_LEN 1000
+
+typedef struct {
+    collex_cowvec_t *vec;
+    size_t reader;
+    size_t snapshots;
+} thread_reader_arg_t;
+
+static atomic_int writer_done;
+
+static size_t count_retired(collex_cowvec_t *vector) {
+    size_t count = 0;
+    for (collex_cowvec_snapshot_t *s = vector->retired; s; s = s->next_retired) {
+        count++;
+    }
+    return count;
+}
+
+void test_cowvec_init_free() {
+    assert(collex_cowvec_init(0, 1) == NULL);
+    assert(collex_cowvec_init(sizeof(int), 0) == NULL);
+    collex_cowvec_t *vec = collex_cowvec_init(sizeof(int), 2);
+    assert(vec != NULL);
+    const collex_cowvec_snapshot_t *snap = collex_cowvec_read_begin(vec, 0);
+    assert(snap && snap->len == 0);
+    assert(collex_cowvec_snapshot_get(snap, 0) == NULL);
+    collex_cowvec_read_end(vec, 0);
+    assert(collex_cowvec_read_begin(vec, 2) == NULL);
+    collex_cowvec_free(vec);
+    printf("test_cowvec_init_free passed\n");
+}
+
+void test_cowvec_push_set_pop() {
+    collex_cowvec_t *vec = collex_cowvec_init(sizeof(int), 1);
+    int n = __COLLEX_COWVEC_CHUNK_LEN_ * 2 + 10;
+    for (int i = 0; i < n; i++) {
+        assert(collex_cowvec_push(vec, &i) == 0);
+    }
+
+    int value = -1;
+    assert(collex_cowvec_set(vec, 700, &value) == 0);
+    assert(collex_cowvec_set(vec, n, &value) == -1);
+
+    const collex_cowvec_snapshot_t *snap = collex_cowvec_read_begin(vec, 0);
+    assert(snap->len == (size_t)n);
+    for (int i = 0; i < n; i++) {
+        const int *x = collex_cowvec_snapshot_get(snap, i);
+        assert(x && *x == (i == 700 ? -1 : i));
+    }
+    collex_cowvec_read_end(vec, 0);
+
+    int popped;
+    assert(collex_cowvec_pop(vec, &popped) == 0);
+    assert(popped == n - 1);
+    value = 42;
+    assert(collex_cowvec_push(vec, &value) == 0);
+    snap = collex_cowvec_read_begin(vec, 0);
+    assert(*(const int *)collex_cowvec_snapshot_get(snap, n - 1) == 42);
+    collex_cowvec_read_end(vec, 0);
+
+    collex_cowvec_free(vec);
+    printf("test_cowvec_push_set_pop passed\n");
+}
+
+void test_cowvec_append() {
+    collex_cowvec_t *vec = collex_cowvec_init(sizeof(int), 1);
+    int values[1500];
+    for (int i = 0; i < 1500; i++) {
+        values[i] = i * 2;
+    }
+    assert(collex_cowvec_append(vec, values, 700) == 0);
+    assert(collex_cowvec_append(vec, values + 700, 800) == 0);
+    assert(collex_cowvec_append(vec, values, 0) == 0);
+
+    const collex_cowvec_snapshot_t *snap = collex_cowvec_read_begin(vec, 0);
+    assert(snap->len == 1500);
+    for (int i = 0; i < 1500; i++) {
+        assert(*(const int *)collex_cowvec_snapshot_get(snap, i) == i * 2);
+    }
+    collex_cowvec_read_end(vec, 0);
+    collex_cowvec_free(vec);
+    printf("test_cowvec_append passed\n");
+}
+
+void test_cowvec_snapshot_isolation() {
+    collex_cowvec_t *vec = collex_cowvec_init(sizeof(int), 2);
+    for (int i = 0; i < 10; i++) {
+        collex_cowvec_push(vec, &i);
+    }
+
+    const collex_cowvec_snapshot_t *old = collex_cowvec_read_begin(vec, 0);
+    int value = 100;
+    collex_cowvec_set(vec, 3, &value);
+    collex_cowvec_pop(vec, NULL);
+    collex_cowvec_push(vec, &value);
+
+    assert(old->len == 10);
+    for (int i = 0; i < 10; i++) {
+        assert(*(const int *)collex_cowvec_snapshot_get(old, i) == i);
+    }
+    assert(count_retired(vec) == 3);
+
+    const collex_cowvec_snapshot_t *fresh = collex_cowvec_read_begin(vec, 1);
+    assert(*(const int *)collex_cowvec_snapshot_get(fresh, 3) == 100);
+    assert(*(const int *)collex_cowvec_snapshot_get(fresh, 9) == 100);
+
+    collex_cowvec_read_end(vec, 0);
+    collex_cowvec_reclaim(vec);
+    assert(count_retired(vec) == 0);
+
+    value = 7;
+    collex_cowvec_set(vec, 0, &value);
+    assert(count_retired(vec) == 1);
+    assert(*(const int *)collex_cowvec_snapshot_get(fresh, 0) == 0);
+    collex_cowvec_read_end(vec, 1);
+    collex_cowvec_reclaim(vec);
+    assert(count_retired(vec) == 0);
+
+    collex_cowvec_free(vec);
+    printf("test_cowvec_snapshot_isolation passed\n");
+}
+
+/* Every element holds its own index in the low 32 bits and a generation in
+ * the high bits, so a reader can spot torn, reused or freed chunks. */
+static uint64_t tagged(uint64_t generation, size_t index) { return generation << 32 | index; }
+
+static void *thread_reader(void *arg) {
+    thread_reader_arg_t *r = arg;
+    uint64_t state = 0x9e3779b97f4a7c15ULL + r->reader;
+    size_t snapshots = 0;
+    while (!atomic_load(&writer_done)) {
+        const collex_cowvec_snapshot_t *snap = collex_cowvec_read_begin(r->vec, r->reader);
+        assert(snap->len >= THREAD_BASE_LEN);
+
+        uint64_t first[16];
+        size_t indices[16];
+        for (size_t i = 0; i < 16; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            indices[i] = state % snap->len;
+            first[i] = *(const uint64_t *)collex_cowvec_snapshot_get(snap, indices[i]);
+            assert((first[i] & 0xffffffffULL) == indices[i]);
+        }
+        const uint64_t *last = collex_cowvec_snapshot_get(snap, snap->len - 1);
+        assert((*last & 0xffffffffULL) == snap->len - 1);
+
+        /* A snapshot is immutable: reading it again must give the same values. */
+        for (size_t i = 0; i < 16; i++) {
+            assert(*(const uint64_t *)collex_cowvec_snapshot_get(snap, indices[i]) == first[i]);
+        }
+
+        collex_cowvec_read_end(r->vec, r->reader);
+        snapshots++;
+    }
+    r->snapshots = snapshots;
+    return NULL;
+}
+
+void test_cowvec_concurrent_readers() {
+    collex_cowvec_t *vec = collex_cowvec_init(sizeof(uint64_t), N_THREAD_READERS);
+    for (size_t i = 0; i < THREAD_BASE_LEN; i++) {
+        uint64_t value = tagged(0, i);
+        assert(collex_cowvec_push(vec, &value) == 0);
+    }
+
+    atomic_store(&writer_done, 0);
+    pthread_t threads[N_THREAD_READERS];
+    thread_reader_arg_t args[N_THREAD_READERS];
+    for (size_t i = 0; i < N_THREAD_READERS; i++) {
+        args[i].vec = vec;
+        args[i].reader = i;
+        args[i].snapshots = 0;
+        assert(pthread_create(&threads[i], NULL, thread_reader, &args[i]) == 0);
+    }
+
+    uint64_t state = 42;
+    size_t len = THREAD_BASE_LEN;
+    for (uint64_t gen = 1; gen <= N_THREAD_WRITES; gen++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        switch (state % 4) {
+        case 0:
+        case 1: {
+            size_t index = (state >> 8) % len;
+            uint64_t value = tagged(gen, index);
+            assert(collex_cowvec_set(vec, index, &value) == 0);
+            break;
+        }
+        case 2: {
+            uint64_t value = tagged(gen, len);
+            assert(collex_cowvec_push(vec, &value) == 0);
+            len++;
+            break;
+        }
+        default:
+            if (len > THREAD_BASE_LEN) {
+                uint64_t value;
+                assert(collex_cowvec_pop(vec, &value) == 0);
+                assert((value & 0xffffffffULL) == len - 1);
+                len--;
+            }
+            break;
+        }
+    }
+    atomic_store(&writer_done, 1);
+
+    for (size_t i = 0; i < N_THREAD_READERS; i++) {
+        assert(pthread_join(threads[i], NULL) == 0);
+        assert(args[i].snapshots > 0);
+    }
+
+    collex_cowvec_reclaim(vec);
+    assert(count_retired(vec) == 0);
+
+    const collex_cowvec_snapshot_t *snap = collex_cowvec_read_begin(vec, 0);
+    assert(snap->len == len);
+    for (size_t i = 0; i < len; i++) {
+        assert((*(const uint64_t *)collex_cowvec_snapshot_get(snap, i) & 0xffffffffULL) == i);
+    }
+    collex_cowvec_read_end(vec, 0);
+    collex_cowvec_free(vec);
+    printf("test_cowvec_concurrent_readers passed\n");
+}
+
+int main() {
+    test_cowvec_init_free();
+    test_cowvec_push_set_pop();
+    test_cowvec_append();
+    test_cowvec_snapshot_isolation();
+    test_cowvec_concurrent_readers();
+    printf("All cowvec tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "collex_lru.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int released_sum = 0;
+static int released_count = 0;
+
+void int_track_release(void *x) {
+    released_sum += *(int *)x;
+    released_count++;
+}
+
+size_t int_hash(const void *x) { return (size_t)*(const int *)x; }
+
+int int_compare(void *x, void *y) {
+    int a = *(int *)x;
+    int b = *(int *)y;
+    return (a > b) - (a < b);
+}
+
+static void reset_released() {
+    released_sum = 0;
+    released_count = 0;
+}
+
+void test_lru_init_invalid() {
+    assert(collex_lru_init(0, sizeof(int), sizeof(int), NULL, NULL, NULL) == NULL);
+    assert(collex_lru_init(4, 0, sizeof(int), NULL, NULL, NULL) == NULL);
+    printf("test_lru_init_invalid passed\n");
+}
+
+void test_lru_put_get() {
+    collex_lru_t *lru = collex_lru_init(4, sizeof(int), sizeof(int), int_hash, int_compare, NULL);
+    assert(lru != NULL);
+    for (int i = 0; i < 4; i++) {
+        int value = i * 10;
+        assert(collex_lru_put(lru, &i, &value) == 0);
+    }
+    assert(lru->len == 4);
+    for (int i = 0; i < 4; i++) {
+        const int *value = collex_lru_get(lru, &i);
+        assert(value && *value == i * 10);
+    }
+    int missing = 99;
+    assert(collex_lru_get(lru, &missing) == NULL);
+
+    int key = 2, value = 7;
+    assert(collex_lru_put(lru, &key, &value) == 0);
+    assert(lru->len == 4);
+    assert(*(int *)collex_lru_get(lru, &key) == 7);
+    collex_lru_free(lru);
+    printf("test_lru_put_get passed\n");
+}
+
+void test_lru_eviction_order() {
+    reset_released();
+    collex_lru_t *lru = collex_lru_init(3, sizeof(int), sizeof(int), int_hash, int_compare, int_track_release);
+    for (int i = 1; i <= 3; i++) {
+        collex_lru_put(lru, &i, &i);
+    }
+
+    int key = 1;
+    assert(collex_lru_get(lru, &key) != NULL);
+    key = 2;
+    assert(collex_lru_peek(lru, &key) != NULL);
+
+    key = 4;
+    collex_lru_put(lru, &key, &key);
+    assert(released_count == 1 && released_sum == 2);
+    key = 2;
+    assert(collex_lru_peek(lru, &key) == NULL);
+
+    key = 5;
+    collex_lru_put(lru, &key, &key);
+    assert(released_count == 2 && released_sum == 5);
+    key = 3;
+    assert(collex_lru_peek(lru, &key) == NULL);
+
+    assert(*(int *)lru->head->key == 5);
+    assert(*(int *)lru->tail->key == 1);
+    collex_lru_free(lru);
+    assert(released_count == 5 && released_sum == 15);
+    printf("test_lru_eviction_order passed\n");
+}
+
+void test_lru_remove_evict() {
+    reset_released();
+    collex_lru_t *lru = collex_lru_init(8, sizeof(int), sizeof(int), NULL, NULL, int_track_release);
+    for (int i = 0; i < 5; i++) {
+        collex_lru_put(lru, &i, &i);
+    }
+
+    int key = 3;
+    assert(collex_lru_remove(lru, &key) == 0);
+    assert(collex_lru_remove(lru, &key) == -1);
+    assert(released_count == 1 && released_sum == 3);
+    assert(lru->len == 4);
+
+    assert(collex_lru_evict(lru) == 0);
+    key = 0;
+    assert(collex_lru_peek(lru, &key) == NULL);
+
+    int value = 40;
+    key = 4;
+    collex_lru_put(lru, &key, &value);
+    assert(released_count == 3 && released_sum == 7);
+
+    while (lru->len) {
+        assert(collex_lru_evict(lru) == 0);
+    }
+    assert(collex_lru_evict(lru) == -1);
+    assert(lru->head == NULL && lru->tail == NULL);
+    collex_lru_free(lru);
+    printf("test_lru_remove_evict passed\n");
+}
+
+void test_lru_churn() {
+    int cap = 64;
+    collex_lru_t *lru = collex_lru_init(cap, sizeof(int), sizeof(int), int_hash, int_compare, NULL);
+    srand(42);
+    for (int i = 0; i < 100000; i++) {
+        int key = rand() % 200;
+        int value = key * 3;
+        if (rand() % 4 == 0) {
+            collex_lru_remove(lru, &key);
+        } else {
+            assert(collex_lru_put(lru, &key, &value) == 0);
+        }
+        assert(lru->len <= (size_t)cap);
+    }
+
+    size_t seen = 0;
+    for (collex_lru_node_t *node = lru->head; node; node = node->next) {
+        int key = *(int *)node->key;
+        const int *value = collex_lru_peek(lru, &key);
+        assert(value && *value == key * 3);
+        seen++;
+    }
+    assert(seen == lru->len);
+
+    size_t indexed = 0;
+    for (size_t i = 0; i <= lru->index_mask; i++) {
+        indexed += lru->index[i] != NULL;
+    }
+    assert(indexed == lru->len);
+    collex_lru_free(lru);
+    printf("test_lru_churn passed\n");
+}
+
+int main() {
+    test_lru_init_invalid();
+    test_lru_put_get();
+    test_lru_eviction_order();
+    test_lru_remove_evict();
+    test_lru_churn();
+    printf("All lru tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "collex_soa.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    int id;
+    double score;
+    char tag;
+} record_t;
+
+static const size_t record_fields[] = {sizeof(int), sizeof(double), sizeof(char)};
+
+#define PACKED_SIZE (sizeof(int) + sizeof(double) + sizeof(char))
+
+int int_cmp(void *x, void *y) {
+    int a = *(int *)x;
+    int b = *(int *)y;
+    return (a > b) - (a < b);
+}
+
+static void pack(char *buffer, record_t record) {
+    memcpy(buffer, &record.id, sizeof(int));
+    memcpy(buffer + sizeof(int), &record.score, sizeof(double));
+    memcpy(buffer + sizeof(int) + sizeof(double), &record.tag, sizeof(char));
+}
+
+static record_t unpack(const char *buffer) {
+    record_t record;
+    memcpy(&record.id, buffer, sizeof(int));
+    memcpy(&record.score, buffer + sizeof(int), sizeof(double));
+    memcpy(&record.tag, buffer + sizeof(int) + sizeof(double), sizeof(char));
+    return record;
+}
+
+static void push_record(collex_soa_t *soa, int id, double score, char tag) {
+    char buffer[PACKED_SIZE];
+    record_t record = {id, score, tag};
+    pack(buffer, record);
+    assert(collex_soa_push(soa, buffer) == 0);
+}
+
+void test_soa_init_invalid() {
+    size_t bad_fields[] = {sizeof(int), 0};
+    assert(collex_soa_init(NULL, 2) == NULL);
+    assert(collex_soa_init(record_fields, 0) == NULL);
+    assert(collex_soa_init(bad_fields, 2) == NULL);
+    printf("test_soa_init_invalid passed\n");
+}
+
+void test_soa_init_free() {
+    collex_soa_t *soa = collex_soa_init(record_fields, 3);
+    assert(soa != NULL);
+    assert(soa->len == 0);
+    assert(soa->cap > 0);
+    assert(soa->record_size == PACKED_SIZE);
+    collex_soa_free(soa);
+    printf("test_soa_init_free passed\n");
+}
+
+void test_soa_push_get() {
+    collex_soa_t *soa = collex_soa_init(record_fields, 3);
+    for (int i = 0; i < 100; i++) {
+        push_record(soa, i, i * 0.5, 'a' + i % 26);
+    }
+    assert(soa->len == 100);
+
+    char buffer[PACKED_SIZE];
+    assert(collex_soa_get(soa, 42, buffer) == 0);
+    record_t record = unpack(buffer);
+    assert(record.id == 42 && record.score == 21.0 && record.tag == 'a' + 42 % 26);
+    assert(collex_soa_get(soa, 100, buffer) == -1);
+
+    const double *score = collex_soa_get_field(soa, 7, 1);
+    assert(score && *score == 3.5);
+    assert(collex_soa_get_field(soa, 7, 3) == NULL);
+    collex_soa_free(soa);
+    printf("test_soa_push_get passed\n");
+}
+
+void test_soa_column() {
+    collex_soa_t *soa = collex_soa_init(record_fields, 3);
+    for (int i = 0; i < 10; i++) {
+        push_record(soa, i, 1.0, 'x');
+    }
+    const int *ids = collex_soa_column(soa, 0);
+    int sum = 0;
+    for (size_t i = 0; i < soa->len; i++) {
+        sum += ids[i];
+    }
+    assert(sum == 45);
+    assert(collex_soa_column(soa, 3) == NULL);
+    collex_soa_free(soa);
+    printf("test_soa_column passed\n");
+}
+
+void test_soa_sort() {
+    collex_soa_t *soa = collex_soa_init(record_fields, 3);
+    int keys[] = {5, 3, 9, 3, 1, 7};
+    for (int i = 0; i < 6; i++) {
+        push_record(soa, keys[i], i, 'a' + i);
+    }
+    assert(collex_soa_sort(soa, 0, int_cmp) == 0);
+
+    int expected_ids[] = {1, 3, 3, 5, 7, 9};
+    char expected_tags[] = {'e', 'b', 'd', 'a', 'f', 'c'};
+    char buffer[PACKED_SIZE];
+    for (size_t i = 0; i < 6; i++) {
+        assert(collex_soa_get(soa, i, buffer) == 0);
+        record_t record = unpack(buffer);
+        assert(record.id == expected_ids[i]);
+        assert(record.tag == expected_tags[i]);
+        assert(record.score == expected_tags[i] - 'a');
+    }
+
+    push_record(soa, 0, 0.0, 'z');
+    assert(*(const char *)collex_soa_get_field(soa, 6, 2) == 'z');
+    assert(collex_soa_sort(soa, 3, int_cmp) == -1);
+    collex_soa_free(soa);
+    printf("test_soa_sort passed\n");
+}
+
+int main() {
+    test_soa_init_invalid();
+    test_soa_init_free();
+    test_soa_push_get();
+    test_soa_column();
+    test_soa_sort();
+    printf("All soa tests passed!\n");
+    return 0;
+}